@@ -0,0 +1,96 @@
+// Per-query cost of the legacy PathExists A* versus the reusable MazeSolver
+// on the Easy, Medium and Hard grid sizes of a 1920x1000 window.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <queue>
+#include <vector>
+#include "maze_generators.h"
+#include "maze_grid.h"
+#include "maze_solver.h"
+
+// The pre-MazeSolver implementation: fresh cost/visited grids and heap per query
+static bool LegacyPathExists(const MazeGrid& grid, int startX, int startY, int endX, int endY) {
+    using Node = std::pair<int, std::pair<int, int>>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> frontier;
+    std::vector<std::vector<int>> cost(grid.getRows(), std::vector<int>(grid.getColumns(), std::numeric_limits<int>::max()));
+    std::vector<std::vector<bool>> visited(grid.getRows(), std::vector<bool>(grid.getColumns(), false));
+
+    frontier.push({0, {startX, startY}});
+    cost[startY][startX] = 0;
+
+    while (!frontier.empty()) {
+        auto [currentCost, current] = frontier.top();
+        frontier.pop();
+        int x = current.first;
+        int y = current.second;
+
+        if (x == endX && y == endY) return true;
+        if (visited[y][x]) continue;
+        visited[y][x] = true;
+
+        for (int i = 0; i < 4; i++) {
+            int nx = x + DIRECTION_DX[i];
+            int ny = y + DIRECTION_DY[i];
+            if (grid.InBounds(nx, ny) && !grid.IsObstacle(nx, ny) && !visited[ny][nx] && !grid.HasWall(x, y, i)) {
+                int newCost = cost[y][x] + 1;
+                if (newCost < cost[ny][nx]) {
+                    cost[ny][nx] = newCost;
+                    frontier.push({newCost + std::abs(nx - endX) + std::abs(ny - endY), {nx, ny}});
+                }
+            }
+        }
+    }
+    return false;
+}
+
+struct BenchCase {
+    const char* name;
+    int cellSize;
+};
+
+int main(int argc, char** argv) {
+    const int queries = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int screenWidth = 1920;
+    const int screenHeight = 1000;
+    const int margin = screenWidth / 64;
+    const BenchCase cases[] = {
+        {"Easy", screenWidth / 48},
+        {"Medium", screenWidth / 64},
+        {"Hard", screenWidth / 80},
+    };
+
+    std::printf("%-8s %9s %14s %14s %9s\n", "Grid", "Cells", "Legacy ns/q", "Solver ns/q", "Speedup");
+    for (const BenchCase& bench : cases) {
+        int cols = (screenWidth - 2 * margin) / bench.cellSize;
+        int rows = (screenHeight - 2 * margin) / bench.cellSize;
+
+        MazeGrid grid;
+        grid.Reset(cols, rows);
+        Xoshiro256 rng(42);
+        CreateMazeGenerator(MazeAlgorithm::Backtracker)->Generate(grid, MazeRegion{0, 0, cols, rows}, rng);
+        for (int i = 0; i < cols * rows / 5; i++) {
+            grid.SetObstacle(1 + rng.NextInt(cols - 1), rng.NextInt(rows), true);
+        }
+
+        std::vector<int> targets(queries);
+        for (int& target : targets) target = rng.NextInt(cols * rows);
+
+        int legacyHits = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int target : targets) legacyHits += LegacyPathExists(grid, 0, 0, target % cols, target / cols);
+        auto t1 = std::chrono::steady_clock::now();
+
+        MazeSolver solver;
+        int solverHits = 0;
+        for (int target : targets) solverHits += solver.PathExists(grid, 0, 0, target % cols, target / cols);
+        auto t2 = std::chrono::steady_clock::now();
+
+        double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / queries;
+        double solverNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / queries;
+        std::printf("%-8s %9d %14.0f %14.0f %8.1fx%s\n", bench.name, cols * rows, legacyNs, solverNs,
+                    legacyNs / solverNs, legacyHits == solverHits ? "" : "  (MISMATCH)");
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "asset_archive.h"
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    bool IsValid(const unsigned char* data, size_t size) {
+        if (size < sizeof(AssetArchiveHeader)) return false;
+        const AssetArchiveHeader* header = reinterpret_cast<const AssetArchiveHeader*>(data);
+        if (std::memcmp(header->magic, ASSET_ARCHIVE_MAGIC, sizeof(header->magic)) != 0) return false;
+        if (header->version != ASSET_ARCHIVE_VERSION) return false;
+        if (header->entryCount > (size - sizeof(AssetArchiveHeader)) / sizeof(AssetEntry)) return false;
+
+        const AssetEntry* entries = reinterpret_cast<const AssetEntry*>(data + sizeof(AssetArchiveHeader));
+        for (uint32_t i = 0; i < header->entryCount; i++) {
+            const AssetEntry& entry = entries[i];
+            if (entry.name[ASSET_NAME_LENGTH - 1] != '\0' || entry.fileType[sizeof(entry.fileType) - 1] != '\0') return false;
+            if (entry.offset > size || entry.size > size - entry.offset) return false;
+            if (i > 0 && std::strcmp(entries[i - 1].name, entry.name) >= 0) return false;
+
+            // Images used in place must hold exactly their pixels
+            if (entry.kind == AssetKind::Image &&
+                entry.rawSize != static_cast<uint64_t>(entry.width) * entry.height * 4) return false;
+            if (entry.codec == AssetCodec::None && entry.size != entry.rawSize) return false;
+        }
+        return true;
+    }
+}
+
+bool AssetArchive::Open(const char* fileName) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    const void* data = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (data == nullptr) {
+        if (mapping != nullptr) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const unsigned char*>(data);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int file = open(fileName, O_RDONLY);
+    if (file < 0) return false;
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(file, &status) == 0 && status.st_size > 0) {
+        data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    // The mapping keeps the file alive
+    close(file);
+    if (data == MAP_FAILED) return false;
+    m_data = static_cast<const unsigned char*>(data);
+    m_size = static_cast<size_t>(status.st_size);
+#endif
+
+    if (!IsValid(m_data, m_size)) {
+        Close();
+        return false;
+    }
+    m_entryCount = reinterpret_cast<const AssetArchiveHeader*>(m_data)->entryCount;
+    m_entries = reinterpret_cast<const AssetEntry*>(m_data + sizeof(AssetArchiveHeader));
+    return true;
+}
+
+void AssetArchive::Close() {
+    if (m_data != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+#else
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_file = nullptr;
+    m_mapping = nullptr;
+}
+
+const AssetEntry* AssetArchive::Find(const char* name) const {
+    int low = 0;
+    int high = static_cast<int>(m_entryCount) - 1;
+    while (low <= high) {
+        const int middle = (low + high) / 2;
+        const int order = std::strcmp(m_entries[middle].name, name);
+        if (order == 0) return &m_entries[middle];
+        if (order < 0) low = middle + 1;
+        else high = middle - 1;
+    }
+    return nullptr;
+}
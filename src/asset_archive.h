@@ -0,0 +1,81 @@
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Packed asset archive ("assets.pak", built by tools/pakbuild). A header is
+// followed by an index of fixed-size entries sorted by name, then the data:
+// sprites as ready-to-upload RGBA8 pixels, sounds as encoded audio. Everything
+// is little-endian, and each entry's data starts 16-byte aligned.
+//
+// Raylib-free; the game turns entries into images and sounds in resources.cpp.
+
+const char ASSET_ARCHIVE_MAGIC[4] = { 'P', 'P', 'A', 'K' };
+const uint32_t ASSET_ARCHIVE_VERSION = 1;
+const char ASSET_ARCHIVE_FILE[] = "assets.pak";
+const int ASSET_NAME_LENGTH = 48;       // Including the terminating zero
+const int ASSET_DATA_ALIGNMENT = 16;
+
+enum class AssetKind : uint32_t {
+    Image = 1,      // width x height RGBA8 pixels
+    Audio = 2       // An encoded audio file of type fileType (e.g. ".qoa")
+};
+
+enum class AssetCodec : uint32_t {
+    None = 0,       // Stored as is and used in place
+    Deflate = 1     // Unpacked into a copy on load
+};
+
+struct AssetArchiveHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct AssetEntry {
+    char name[ASSET_NAME_LENGTH];       // Path the asset was built from, e.g. "Assets/monkey.png"
+    AssetKind kind;
+    AssetCodec codec;
+    uint64_t offset;                    // From the start of the file
+    uint64_t size;                      // Stored bytes
+    uint64_t rawSize;                   // Bytes once unpacked
+    uint32_t width;                     // Images only
+    uint32_t height;
+    char fileType[8];                   // Audio only, with the dot
+};
+
+static_assert(sizeof(AssetArchiveHeader) == 16, "archive header layout");
+static_assert(sizeof(AssetEntry) == 96, "archive entry layout");
+
+// Read-only, memory-mapped view of an archive. Entry data is used straight
+// from the mapping, so pointers stay valid until Close(). Safe to read from
+// several threads once opened.
+class AssetArchive {
+public:
+    AssetArchive() = default;
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+    ~AssetArchive() { Close(); }
+
+    // Fails on a missing file or any malformed header, index or entry bounds
+    bool Open(const char* fileName);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+
+    // Binary search over the sorted index; nullptr when absent
+    const AssetEntry* Find(const char* name) const;
+    const unsigned char* Data(const AssetEntry& entry) const { return m_data + entry.offset; }
+    int getEntryCount() const { return static_cast<int>(m_entryCount); }
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    const AssetEntry* m_entries = nullptr;
+    uint32_t m_entryCount = 0;
+    void* m_file = nullptr;             // Windows file and mapping handles
+    void* m_mapping = nullptr;
+};
+
+#endif
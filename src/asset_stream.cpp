@@ -0,0 +1,66 @@
+#include "asset_stream.h"
+#include <utility>
+
+void AssetStreamer::Start() {
+    m_stopping = false;
+    for (int i = 0; i < ASSET_STREAM_WORKERS; i++) {
+        m_workers.emplace_back(&AssetStreamer::WorkerLoop, this);
+    }
+}
+
+void AssetStreamer::Submit(std::function<void()> work, std::function<void()> finish) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued.push_back(Job{ std::move(work), std::move(finish) });
+    }
+    if (m_workers.empty()) Start();
+    m_wake.notify_one();
+}
+
+void AssetStreamer::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_stopping || !m_queued.empty(); });
+        if (m_stopping) return;
+
+        Job job = std::move(m_queued.front());
+        m_queued.pop_front();
+        m_running++;
+        lock.unlock();
+        job.work();
+        lock.lock();
+        m_running--;
+        m_done.push_back(std::move(job));
+    }
+}
+
+void AssetStreamer::Update() {
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_done.empty()) return;
+        done.swap(m_done);
+    }
+    for (Job& job : done) job.finish();
+}
+
+void AssetStreamer::Stop() {
+    Join();
+    Update();
+}
+
+void AssetStreamer::Join() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_queued.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) worker.join();
+    m_workers.clear();
+}
+
+int AssetStreamer::getPending() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_queued.size() + m_done.size()) + m_running;
+}
@@ -0,0 +1,53 @@
+#ifndef ASSET_STREAM_H
+#define ASSET_STREAM_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Decoding threads; image and audio decoding is I/O and CPU bound, one spare core is enough
+const int ASSET_STREAM_WORKERS = 2;
+// Texture bytes the main thread uploads per frame while streamed assets arrive
+const int ASSET_UPLOAD_BUDGET_BYTES = 256 * 1024;
+
+// Background asset decoding. Each job's work step runs on a worker thread and
+// must only touch CPU memory (LoadImage, LoadFileData, image operations);
+// its finish step runs on the main thread from Update(), where GPU and audio
+// device calls are allowed.
+class AssetStreamer {
+public:
+    // Finish steps left at exit are dropped with the process
+    ~AssetStreamer() { Join(); }
+
+    // Workers start with the first job
+    void Submit(std::function<void()> work, std::function<void()> finish);
+    // Runs the finish steps of completed jobs, in completion order
+    void Update();
+    // Joins the workers. Jobs not yet started are dropped; finished ones still complete.
+    void Stop();
+    // Jobs submitted whose finish step has not run yet
+    int getPending() const;
+
+private:
+    struct Job {
+        std::function<void()> work;
+        std::function<void()> finish;
+    };
+
+    void Start();
+    void Join();
+    void WorkerLoop();
+
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Job> m_queued;
+    std::vector<Job> m_done;
+    int m_running = 0;
+    bool m_stopping = false;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "camera_view.h"
+#include <algorithm>
+#include <cmath>
+#include "game_state.h"
+
+namespace {
+    // Camera target along one axis: identity when the world fits the view,
+    // otherwise the focus clamped so the view stays inside the world
+    float FollowAxis(float focus, float worldSize, float viewSize) {
+        if (worldSize <= viewSize) return viewSize / 2;
+        return std::clamp(focus, viewSize / 2, worldSize - viewSize / 2);
+    }
+}
+
+void FollowPlayerCamera() {
+    const float cellSize = static_cast<float>(GAME_STATE.getCellSize());
+    const float margin = static_cast<float>(GAME_STATE.getMargin());
+    const float screenWidth = static_cast<float>(GAME_STATE.getScreenWidth());
+    const float screenHeight = static_cast<float>(GAME_STATE.getScreenHeight());
+
+    float playerX = margin + GAME_STATE.getRenderPlayerPosX() * cellSize + cellSize / 2;
+    float playerY = margin + GAME_STATE.getRenderPlayerPosY() * cellSize + cellSize / 2;
+
+    Camera2D& camera = GAME_STATE.getCamera();
+    camera.offset = Vector2{ screenWidth / 2, screenHeight / 2 };
+    // Whole pixels keep the cached maze chunks sampled 1:1
+    camera.target = Vector2{
+        std::round(FollowAxis(playerX, GAME_STATE.getMazeWidth() + 2 * margin, screenWidth)),
+        std::round(FollowAxis(playerY, GAME_STATE.getMazeHeight() + 2 * margin, screenHeight))
+    };
+    camera.rotation = 0.0f;
+    camera.zoom = 1.0f;
+}
+
+Rectangle GetCameraView() {
+    const Camera2D& camera = GAME_STATE.getCamera();
+    float width = GAME_STATE.getScreenWidth() / camera.zoom;
+    float height = GAME_STATE.getScreenHeight() / camera.zoom;
+    return Rectangle{ camera.target.x - camera.offset.x / camera.zoom, camera.target.y - camera.offset.y / camera.zoom,
+                      width, height };
+}
+
+CellRect GetVisibleCells(int padding) {
+    const Rectangle view = GetCameraView();
+    const float cellSize = static_cast<float>(GAME_STATE.getCellSize());
+    const float margin = static_cast<float>(GAME_STATE.getMargin());
+
+    CellRect cells;
+    cells.x0 = static_cast<int>(std::floor((view.x - margin) / cellSize)) - padding;
+    cells.y0 = static_cast<int>(std::floor((view.y - margin) / cellSize)) - padding;
+    cells.x1 = static_cast<int>(std::floor((view.x + view.width - margin) / cellSize)) + padding;
+    cells.y1 = static_cast<int>(std::floor((view.y + view.height - margin) / cellSize)) + padding;
+
+    cells.x0 = std::max(cells.x0, 0);
+    cells.y0 = std::max(cells.y0, 0);
+    cells.x1 = std::min(cells.x1, GAME_STATE.getColumns() - 1);
+    cells.y1 = std::min(cells.y1, GAME_STATE.getRows() - 1);
+    return cells;
+}
+
+bool IsCircleVisible(Vector2 center, float radius) {
+    return CheckCollisionCircleRec(center, radius, GetCameraView());
+}
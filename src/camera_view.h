@@ -0,0 +1,27 @@
+#ifndef CAMERA_VIEW_H
+#define CAMERA_VIEW_H
+
+#include "raylib.h"
+
+// Inclusive range of grid cells; empty when x0 > x1 or y0 > y1
+struct CellRect {
+    int x0, y0;
+    int x1, y1;
+
+    bool IsEmpty() const { return x0 > x1 || y0 > y1; }
+    bool Contains(int x, int y) const { return x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+};
+
+// Centre the camera on the player, clamped so it never shows past the maze
+// edges. Mazes that fit on the screen keep the fixed, unscrolled layout.
+void FollowPlayerCamera();
+
+// World-space rectangle currently on screen
+Rectangle GetCameraView();
+
+// Cells intersecting the view, grown by padding cells and clamped to the grid
+CellRect GetVisibleCells(int padding = 0);
+
+bool IsCircleVisible(Vector2 center, float radius);
+
+#endif
@@ -0,0 +1,107 @@
+#include "endless_maze.h"
+#include <algorithm>
+
+void EllerRowGenerator::Reset(int columns, uint64_t seed) {
+    m_cols = columns;
+    m_sets.assign(columns, -1);
+    m_used.assign(columns, 0);
+    m_rng.Seed(seed);
+}
+
+// A row never holds more than m_cols sets, so labels stay in [0, m_cols)
+int EllerRowGenerator::NewLabel() {
+    while (m_used[m_labelCursor]) m_labelCursor++;
+    m_used[m_labelCursor] = 1;
+    return m_labelCursor;
+}
+
+void EllerRowGenerator::CarveRow(MazeGrid& grid, int y) {
+    // Cells not reached from above start their own set
+    m_labelCursor = 0;
+    for (int x = 0; x < m_cols; x++) {
+        if (m_sets[x] < 0) m_sets[x] = NewLabel();
+    }
+
+    // Randomly join neighbours that belong to different sets. Since every run
+    // opens downward, a row can end up as one set of single-cell runs, which
+    // would then repeat forever as straight corridors. Joining within a set
+    // now and then breaks that; it only closes a loop through rows above
+    for (int x = 0; x + 1 < m_cols; x++) {
+        if (m_rng() & 1) continue;
+        if (m_sets[x] == m_sets[x + 1] && m_rng.NextInt(ELLER_LOOP_ODDS) != 0) continue;
+
+        grid.RemoveWall(x, y, 1);
+        int merged = m_sets[x + 1];
+        for (int k = 0; k < m_cols; k++) {
+            if (m_sets[k] == merged) m_sets[k] = m_sets[x];
+        }
+    }
+
+    // Open random cells downward, and at least one per horizontal run. That is
+    // stricter than one per set, but it means every cell can descend without
+    // routing through rows that have already been evicted
+    int runStart = 0;
+    bool runOpened = false;
+    for (int x = 0; x < m_cols; x++) {
+        if (m_rng() & 1) {
+            grid.RemoveWall(x, y, 2);
+            runOpened = true;
+        }
+
+        if (x + 1 == m_cols || grid.HasWall(x, y, 1)) {
+            if (!runOpened) {
+                grid.RemoveWall(runStart + m_rng.NextInt(x - runStart + 1), y, 2);
+            }
+            runStart = x + 1;
+            runOpened = false;
+        }
+    }
+
+    // Carry labels down through the openings
+    std::fill(m_used.begin(), m_used.end(), 0);
+    for (int x = 0; x < m_cols; x++) {
+        if (grid.HasWall(x, y, 2)) {
+            m_sets[x] = -1;
+        } else {
+            m_used[m_sets[x]] = 1;
+        }
+    }
+}
+
+void EndlessMaze::Start(MazeGrid& grid, int columns, int rows, uint64_t seed, float obstacleChance) {
+    grid.Reset(columns, rows);
+    m_rng.Seed(seed);
+    m_rows.Reset(columns, m_rng());
+    m_obstacleChance = obstacleChance;
+
+    for (int y = 0; y < rows; y++) {
+        CarveNextRow(grid, y);
+    }
+}
+
+void EndlessMaze::Advance(MazeGrid& grid) {
+    grid.ShiftRowsUp(1);
+    CarveNextRow(grid, grid.getRows() - 1);
+}
+
+void EndlessMaze::CarveNextRow(MazeGrid& grid, int y) {
+    // The row above opened its bottom walls before this row was resident
+    if (y > 0) {
+        for (int x = 0; x < grid.getColumns(); x++) {
+            if (!grid.HasWall(x, y - 1, 2)) grid.RemoveWall(x, y - 1, 2);
+        }
+    }
+
+    m_rows.CarveRow(grid, y);
+
+    // Obstacles only go on dead ends: removing leaves never disconnects a tree
+    for (int x = 0; x < grid.getColumns(); x++) {
+        bool isStart = x == 0 && grid.getRowOrigin() + y == 0;
+        int walls = grid.Walls(x, y);
+        int openings = 4 - ((walls & 1) + ((walls >> 1) & 1) + ((walls >> 2) & 1) + ((walls >> 3) & 1));
+
+        if (openings == 1 && !isStart && m_rng.NextFloat() < m_obstacleChance) {
+            grid.SetObstacle(x, y, true);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef ENDLESS_MAZE_H
+#define ENDLESS_MAZE_H
+
+#include <vector>
+#include "maze_grid.h"
+#include "rng.h"
+
+// 1 in ELLER_LOOP_ODDS neighbours of the same set are joined anyway
+const int ELLER_LOOP_ODDS = 8;
+
+// Eller's algorithm: carves the maze one row at a time while keeping only the
+// set label of each column (O(width) state). Every horizontal run opens at
+// least one passage downward, so any cell can keep descending forever.
+class EllerRowGenerator {
+public:
+    void Reset(int columns, uint64_t seed);
+
+    // Carves horizontal joins and downward openings of row `y`
+    void CarveRow(MazeGrid& grid, int y);
+
+private:
+    int NewLabel();
+
+    int m_cols = 0;
+    int m_labelCursor = 0;
+    std::vector<int> m_sets;        // Set label per column of the row being carved (-1: none yet)
+    std::vector<uint8_t> m_used;    // Per label: used by the next row
+    Xoshiro256 m_rng;
+};
+
+// Sliding window over an endless maze. The MazeGrid holds only the resident
+// rows; Advance() evicts the top row and carves one new row at the bottom.
+class EndlessMaze {
+public:
+    void Start(MazeGrid& grid, int columns, int rows, uint64_t seed, float obstacleChance);
+    void Advance(MazeGrid& grid);
+
+private:
+    void CarveNextRow(MazeGrid& grid, int y);
+
+    EllerRowGenerator m_rows;
+    Xoshiro256 m_rng;
+    float m_obstacleChance = 0.0f;
+};
+
+#endif
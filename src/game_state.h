@@ -4,12 +4,14 @@
 #include "raylib.h"
 #include "resources.h"
 #include <mutex>
+#include <random>
 #include <vector>
-#include <stack>
 #include "maze.h"
-
-// Forward declaration of Cell struct
-struct Cell;
+#include "maze_grid.h"
+#include "endless_maze.h"
+#include "maze_solver.h"
+#include "reachability.h"
+#include "rng.h"
 
 class GameState {
 public:
@@ -30,13 +32,22 @@ public:
         m_screenWidth = width;
         m_screenHeight = height;
         updateDerivedValues();
+        m_mazeLayerDirty = true;
     }
 
+    // World-to-screen view; follows the player when the maze is larger than the screen
+    Camera2D& getCamera() { return m_camera; }
+
+    // Cached wall/obstacle layer must be re-rendered (maze, theme or screen changed)
+    bool getMazeLayerDirty() const { return m_mazeLayerDirty; }
+    void setMazeLayerDirty(bool dirty) { m_mazeLayerDirty = dirty; }
+
     // Game Theme Management
     GameTheme getCurrentTheme() const { return m_currentTheme; }
     void setCurrentTheme(GameTheme theme) { 
         m_currentTheme = theme; 
         updateThemeColors();
+        m_mazeLayerDirty = true;
     }
 
     // Game State Properties
@@ -72,12 +83,25 @@ public:
     int getMazeHeight() const { return m_mazeHeight; }
     int getColumns() const { return m_cols; }
     int getRows() const { return m_rows; }
+    // Fixed maze size in cells, independent of the screen; 0 x 0 fits the maze to the screen
+    void setMazeDimensions(int columns, int rows) {
+        m_fixedColumns = columns;
+        m_fixedRows = rows;
+        updateDerivedValues();
+    }
+    bool getMazeFitsScreen() const { return m_fixedColumns <= 0 || m_fixedRows <= 0; }
     int getExitX() const { return exitX; }
     int getExitY() const { return exitY; }
     void setExitX(int exitX) { this->exitX = exitX; }
     void setExitY(int exitY) { this->exitY = exitY; }
     float getObstaclePercentage() const { return m_obstaclePercentage; }
     void setObstaclePercentage(float percentage) { m_obstaclePercentage = percentage; }
+    GenerationMode getGenerationMode() const { return m_generationMode; }
+    void setGenerationMode(GenerationMode mode) { m_generationMode = mode; }
+    MazeAlgorithm getMazeAlgorithm() const { return m_mazeAlgorithm; }
+    void setMazeAlgorithm(MazeAlgorithm algorithm) { m_mazeAlgorithm = algorithm; }
+    ExitPlacement getExitPlacement() const { return m_exitPlacement; }
+    void setExitPlacement(ExitPlacement placement) { m_exitPlacement = placement; }
 
     // Player Movement Parameters
     int getPlayerX() const { return playerX; }
@@ -101,13 +125,31 @@ public:
     float getPlayerSpeed() const { return playerSpeed; }
     float getRotationSpeed() const { return rotationSpeed; }
 
+    // Pose at the previous simulation tick; rendering blends it with the
+    // current pose by how far the frame is into the next tick
+    void savePreviousPlayerPose() {
+        prevPlayerPosX = playerPosX;
+        prevPlayerPosY = playerPosY;
+        prevPlayerRotation = playerRotation;
+    }
+    float getPreviousPlayerPosY() const { return prevPlayerPosY; }
+    void setPreviousPlayerPosY(float posY) { prevPlayerPosY = posY; }
+    float getTickAlpha() const { return tickAlpha; }
+    void setTickAlpha(float alpha) { tickAlpha = alpha; }
+    float getRenderPlayerPosX() const { return prevPlayerPosX + (playerPosX - prevPlayerPosX) * tickAlpha; }
+    float getRenderPlayerPosY() const { return prevPlayerPosY + (playerPosY - prevPlayerPosY) * tickAlpha; }
+    float getRenderPlayerRotation() const {
+        float diff = playerRotation - prevPlayerRotation;
+        if (diff > 180.0f) diff -= 360.0f;
+        if (diff < -180.0f) diff += 360.0f;
+        return prevPlayerRotation + diff * tickAlpha;
+    }
+
     // Timed Mode Parameters
     float getTimeLimit() const { return timeLimit; }
     void setTimeLimit(float limit) { timeLimit = limit; }
     float getStartTime() const { return startTime; }
     void setStartTime(float time) { startTime = time; }
-    float getTotalPausedTime() const { return totalPausedTime; }
-    void setTotalPausedTime(float time) { totalPausedTime = time; }
     float getTimeElapsed() const { return timeElapsed; }
     void setTimeElapsed(float time) { timeElapsed = time; }
 
@@ -124,16 +166,36 @@ public:
     void setSpeedBoostTimeLeft(float time) { speedBoostTimeLeft = time; }
     bool getIsSpeedBoosted() const { return isSpeedBoosted; }
     void setIsSpeedBoosted(bool boosted) { isSpeedBoosted = boosted; }
+    bool getShowDebugOverlay() const { return showDebugOverlay; }
+    void setShowDebugOverlay(bool show) { showDebugOverlay = show; }
+    bool getUseShaderMaze() const { return useShaderMaze; }
+    void setUseShaderMaze(bool use) { useShaderMaze = use; }
+    bool getUseAdaptiveResolution() const { return useAdaptiveResolution; }
+    void setUseAdaptiveResolution(bool use) { useAdaptiveResolution = use; }
+
+    // Endless Mode Parameters
+    long long getEndlessDepth() const { return endlessDepth; }
+    void setEndlessDepth(long long depth) { endlessDepth = depth; }
+    long long getNextMilestone() const { return nextMilestone; }
+    void setNextMilestone(long long row) { nextMilestone = row; }
 
     const char* getScoresFile() const { return SCORES_FILE; }
 
-    std::vector<std::vector<Cell>>& getGrid() { return m_grid; }
-    std::stack<Cell*>& getStack() { return m_stack; }
+    MazeGrid& getGrid() { return m_grid; }
+    EndlessMaze& getEndlessMaze() { return m_endlessMaze; }
+    MazeSolver& getSolver() { return m_solver; }
+    ReachabilityBitboard& getReachability() { return m_reachability; }
+    RandomService& getRandom() { return m_random; }
+
+    // Seed the current maze was built from; replaying it rebuilds the same maze
+    uint64_t getMazeSeed() const { return m_mazeSeed; }
+    void setMazeSeed(uint64_t seed) { m_mazeSeed = seed; }
 
 private:
     // Private constructor to prevent direct instantiation
     GameState() {
         m_cellSize = m_screenWidth / 48; // Default to Easy difficulty cell size
+        m_random.SeedSession(std::random_device{}()); // The only entropy syscall; main() may override it
         updateDerivedValues();
         updateThemeColors();
     }
@@ -141,10 +203,17 @@ private:
     void updateDerivedValues() {
         // Recalculate maze parameters based on screen dimensions
         m_margin = m_screenWidth / 64;
-        m_mazeWidth = m_screenWidth - 2 * m_margin;
-        m_mazeHeight = m_screenHeight - 2 * m_margin;
-        m_cols = m_mazeWidth / m_cellSize;
-        m_rows = m_mazeHeight / m_cellSize;
+        if (getMazeFitsScreen()) {
+            m_mazeWidth = m_screenWidth - 2 * m_margin;
+            m_mazeHeight = m_screenHeight - 2 * m_margin;
+            m_cols = m_mazeWidth / m_cellSize;
+            m_rows = m_mazeHeight / m_cellSize;
+        } else {
+            m_cols = m_fixedColumns;
+            m_rows = m_fixedRows;
+            m_mazeWidth = m_cols * m_cellSize;
+            m_mazeHeight = m_rows * m_cellSize;
+        }
     }
 
     void updateThemeColors() {
@@ -176,6 +245,8 @@ private:
     GameMode m_currentMode = GameMode::Untimed;
     MenuState m_menuState = MenuState::DifficultySelect;
     SoundSettings m_soundSettings = SoundSettings::AllOn;
+    bool m_mazeLayerDirty = true;
+    Camera2D m_camera = {{0, 0}, {0, 0}, 0.0f, 1.0f};
     
     // Current Theme Colors
     ThemeColors m_currentColors;
@@ -187,9 +258,14 @@ private:
     int m_mazeHeight;
     int m_cols;
     int m_rows;
+    int m_fixedColumns = 0;
+    int m_fixedRows = 0;
     int exitX;
     int exitY;
     float m_obstaclePercentage = 0.15f;
+    GenerationMode m_generationMode = GenerationMode::Serial;
+    MazeAlgorithm m_mazeAlgorithm = MazeAlgorithm::Backtracker;
+    ExitPlacement m_exitPlacement = ExitPlacement::Random;
 
 
     // Player position and rotation
@@ -203,11 +279,14 @@ private:
     float playerRotation = 0.0f;         // Current rotation angle
     float targetRotation = 0.0f;         // Target rotation angle
     const float rotationSpeed = 10.0f;   // Rotation speed multiplier
+    float prevPlayerPosX = 0.0f;
+    float prevPlayerPosY = 0.0f;
+    float prevPlayerRotation = 0.0f;
+    float tickAlpha = 0.0f;              // Fraction of a tick since the last one, [0, 1)
 
     int timeLimit = 120.0f; // Seconds
     float startTime = 0.0f;
-    float totalPausedTime = 0.0f;
-    float timeElapsed;
+    float timeElapsed;                   // Sum of simulation ticks; paused time never counts
 
     bool gameWon = false;
     float TIME_BONUS_AMOUNT = 10.0f;
@@ -215,10 +294,19 @@ private:
     bool showTimeBonusFeedback = false;
     float speedBoostTimeLeft = 0.0f;
     bool isSpeedBoosted = false;
+    bool showDebugOverlay = false;
+    bool useShaderMaze = false;
+    bool useAdaptiveResolution = false;
+    long long endlessDepth = 0;
+    long long nextMilestone = 0;
     static constexpr const char* SCORES_FILE = "highscores.dat";
 
-    std::vector<std::vector<Cell>> m_grid;
-    std::stack<Cell*> m_stack;
+    MazeGrid m_grid;
+    EndlessMaze m_endlessMaze;
+    MazeSolver m_solver;
+    ReachabilityBitboard m_reachability;
+    RandomService m_random;
+    uint64_t m_mazeSeed = 0;
 };
 
 // Convenience macro for global access
@@ -1,39 +1,52 @@
 #include "gameplay.h"
 #include "maze.h"
 #include "resources.h"
-
-Particle::Particle() : lifetime(0), active(false) {}
+#include "ui.h"
 
 std::vector<TimePowerup> timePowerups(MAX_TIME_POWERUPS);
 std::vector<SpeedBoost> speedBoosts(5);  // 5 speed boosts max
 
+// Emitters registered on GameResources::particles by InitParticleEmitters()
+int portalEmitter = -1;
+int dustEmitter = -1;
+int leafEmitter = -1;
+
 TimePowerup::TimePowerup() : active(false), rotationAngle(0.0f) {}
 
 SpeedBoost::SpeedBoost() : active(false) {}
 
 DifficultySettings DifficultySettings::Get(Difficulty diff) {
+    MazeRules rules = MazeRules::Get(diff);
     switch(diff) {
         case Easy:
-            return {GAME_STATE.getScreenWidth()/48, 0.15f, 10.0f};
+            return {GAME_STATE.getScreenWidth()/48, rules.obstaclePercentage, 10.0f, rules.algorithm, rules.exitPlacement};
         case Medium:
-            return {GAME_STATE.getScreenWidth()/64, 0.20f, 8.0f};
+            return {GAME_STATE.getScreenWidth()/64, rules.obstaclePercentage, 8.0f, rules.algorithm, rules.exitPlacement};
         case Hard:
-            return {GAME_STATE.getScreenWidth()/80, 0.25f, 5.0f};
+            return {GAME_STATE.getScreenWidth()/80, rules.obstaclePercentage, 5.0f, rules.algorithm, rules.exitPlacement};
         default:
-            return {GAME_STATE.getScreenWidth()/48, 0.15f, 10.0f};
+            return {GAME_STATE.getScreenWidth()/48, rules.obstaclePercentage, 10.0f, rules.algorithm, rules.exitPlacement};
     }
 }
 
 void ResetGame() {
     // Re-initialize grid with new cell size and related properties
-    GAME_STATE.getGrid().clear();
-    GAME_STATE.getGrid().resize(GAME_STATE.getRows(), std::vector<Cell>(GAME_STATE.getColumns(), Cell(0, 0)));
+    InitializeGrid();
+
+    // Every maze gets its own seed; the maze streams are all derived from it
+    RandomService& random = GAME_STATE.getRandom();
+    GAME_STATE.setMazeSeed(random.Stream(RngStream::Session)());
+    random.BeginMaze(GAME_STATE.getMazeSeed());
+    GAME_STATE.getGrid().setVariantSeed(static_cast<uint32_t>(random.Stream(RngStream::Maze)()));
     
     // Reinitialize maze
-    InitializeGrid();
-    GenerateMaze();
-    PlaceRandomExit();
-    AddRandomObstacles(GAME_STATE.getExitX(), GAME_STATE.getExitY());
+    if (GAME_STATE.getCurrentMode() == Endless) {
+        StartEndlessMaze();
+    } else {
+        GenerateMaze();
+        PlaceRandomExit();
+        AddRandomObstacles(GAME_STATE.getExitX(), GAME_STATE.getExitY());
+    }
 
     // Reset speed boost variables
     GAME_STATE.setIsSpeedBoosted(false);
@@ -44,12 +57,15 @@ void ResetGame() {
         GAME_STATE.setTimeLimit(120.0f);
         timePowerups.clear();
         timePowerups.resize(MAX_TIME_POWERUPS);
+    } else if (GAME_STATE.getCurrentMode() == Endless) {
+        GAME_STATE.setTimeLimit(ENDLESS_TIME_LIMIT);
+        timePowerups.clear();
+        timePowerups.resize(MAX_TIME_POWERUPS);
     }
 
     SpawnPowerups();
     
     GAME_STATE.setStartTime(GetTime());
-    GAME_STATE.setTotalPausedTime(0.0f);
     GAME_STATE.setTimeElapsed(0.0f);
     
     // Reset player and target position and rotation
@@ -58,8 +74,86 @@ void ResetGame() {
     GAME_STATE.setPlayerTargetX(0); GAME_STATE.setPlayerTargetY(0);
     GAME_STATE.setPlayerRotation(0); GAME_STATE.setTargetRotation(0);
     GAME_STATE.setIsMoving(false);
+    GAME_STATE.savePreviousPlayerPose();
 
     GAME_STATE.setGameWon(false);
+    GAME_STATE.setMazeLayerDirty(true);
+    GameResources::particles.Clear();
+}
+
+// Endless mode has no exit: the grid is a window of resident rows that scrolls with the player
+void StartEndlessMaze() {
+    MazeGrid& grid = GAME_STATE.getGrid();
+    GAME_STATE.getEndlessMaze().Start(grid, GAME_STATE.getColumns(), GAME_STATE.getRows(),
+                                      GAME_STATE.getRandom().Stream(RngStream::Endless)(), GAME_STATE.getObstaclePercentage());
+
+    GAME_STATE.setExitX(-1);
+    GAME_STATE.setExitY(-1);
+    GAME_STATE.setEndlessDepth(0);
+    GAME_STATE.setNextMilestone(ENDLESS_MILESTONE_ROWS);
+}
+
+// Evict the top row, carve a new bottom row and move everything on the grid up with it
+void ScrollEndlessMaze() {
+    MazeGrid& grid = GAME_STATE.getGrid();
+    GAME_STATE.getEndlessMaze().Advance(grid);
+    GAME_STATE.setMazeLayerDirty(true);
+
+    GAME_STATE.setPlayerY(GAME_STATE.getPlayerY() - 1);
+    GAME_STATE.setPlayerPosY(GAME_STATE.getPlayerPosY() - 1.0f);
+    GAME_STATE.setPreviousPlayerPosY(GAME_STATE.getPreviousPlayerPosY() - 1.0f);
+    GAME_STATE.setPlayerTargetY(GAME_STATE.getPlayerTargetY() - 1.0f);
+
+    // Boosts that scroll off the top reappear somewhere in the new bottom row
+    const int newRow = grid.getRows() - 1;
+    Xoshiro256& rng = GAME_STATE.getRandom().Stream(RngStream::Powerups);
+    for (auto& boost : speedBoosts) {
+        if (--boost.y >= 0) continue;
+
+        boost.active = false;
+        for (int attempt = 0; attempt < grid.getColumns(); attempt++) {
+            int x = rng.NextInt(grid.getColumns());
+            if (!grid.IsObstacle(x, newRow)) {
+                boost.x = x;
+                boost.y = newRow;
+                boost.active = GAME_STATE.getCurrentDifficulty() != Difficulty::Easy;
+                break;
+            }
+        }
+    }
+}
+
+void UpdateEndlessMode() {
+    // Keep the player in the upper half of the window; one row per step keeps frames flat
+    if (GAME_STATE.getPlayerY() > GAME_STATE.getRows() / 2) {
+        ScrollEndlessMaze();
+    }
+
+    long long depth = GAME_STATE.getGrid().getRowOrigin() + GAME_STATE.getPlayerY();
+    if (depth > GAME_STATE.getEndlessDepth()) {
+        GAME_STATE.setEndlessDepth(depth);
+    }
+
+    // Distance milestones replace the exit: each one extends the clock
+    if (GAME_STATE.getEndlessDepth() >= GAME_STATE.getNextMilestone()) {
+        GameResources::sfx.Play(SfxId::Bonus);
+        GAME_STATE.setTimeLimit(GAME_STATE.getTimeLimit() + GAME_STATE.getTimeBonusAmount());
+        GAME_STATE.setShowTimeBonusFeedback(true);
+        GAME_STATE.setTimeBonusFeedbackTimer(TIME_BONUS_FEEDBACK_DURATION);
+        GAME_STATE.setNextMilestone(GAME_STATE.getNextMilestone() + ENDLESS_MILESTONE_ROWS);
+    }
+}
+
+void DrawEndlessMilestone() {
+    int row = static_cast<int>(GAME_STATE.getNextMilestone() - GAME_STATE.getGrid().getRowOrigin());
+    const CellRect visible = GetVisibleCells();
+    if (row < visible.y0 || row > visible.y1) return;
+
+    int y = GAME_STATE.getMargin() + row * GAME_STATE.getCellSize();
+    DrawRectangle(GAME_STATE.getMargin(), y, GAME_STATE.getColumns() * GAME_STATE.getCellSize(), GAME_STATE.getCellSize(),
+                  ColorAlpha(GAME_STATE.getCurrentColors().goalColor, 0.15f));
+    DrawText(TextFormat("%lld", GAME_STATE.getNextMilestone()), GAME_STATE.getMargin() + 4, y + 2, 10,
+             GAME_STATE.getCurrentColors().goalColor);
 }
 
 void InitializeGameWithDifficulty() {
@@ -68,19 +162,25 @@ void InitializeGameWithDifficulty() {
     GAME_STATE.setTimeBonusAmount(settings.timeBonusAmount);
     GAME_STATE.setCellSize(settings.cellSize);
     GAME_STATE.setObstaclePercentage(settings.obstaclePercentage);
-    GAME_STATE.setTotalPausedTime(0.0f);
+    GAME_STATE.setMazeAlgorithm(settings.algorithm);
+    GAME_STATE.setExitPlacement(settings.exitPlacement);
     GAME_STATE.setTimeElapsed(0.0f);
 
     // Resize grid with new dimensions
     ResetGame();
 }
 
-// Maintain a list of all valid cells for powerup placement
+// Maintain a list of all valid cells for powerup placement.
+// Obstacles can seal off dead ends, so only cells reachable from the start qualify.
 void PrecomputeValidCells(std::vector<std::pair<int, int>>& validCells) {
+    ReachabilityBitboard& reachability = GAME_STATE.getReachability();
+    reachability.Build(GAME_STATE.getGrid());
+    reachability.Flood(0, 0);
+
     validCells.clear();
     for (int y = 0; y < GAME_STATE.getRows(); y++) {
         for (int x = 0; x < GAME_STATE.getColumns(); x++) {
-            if (!GAME_STATE.getGrid()[y][x].isObstacle && !(x == 0 && y == 0) && !(x == GAME_STATE.getExitX() && y == GAME_STATE.getExitY())) {
+            if (reachability.IsReachable(x, y) && !(x == 0 && y == 0) && !(x == GAME_STATE.getExitX() && y == GAME_STATE.getExitY())) {
                 validCells.emplace_back(x, y);
             }
         }
@@ -90,11 +190,12 @@ void PrecomputeValidCells(std::vector<std::pair<int, int>>& validCells) {
 void SpawnPowerups() {
     std::vector<std::pair<int, int>> validCells;
     PrecomputeValidCells(validCells);
+    Xoshiro256& rng = GAME_STATE.getRandom().Stream(RngStream::Powerups);
 
     if (GAME_STATE.getCurrentMode() == Timed) {
         // Spawn time power-ups
         for (int i = 0; i < MAX_TIME_POWERUPS && !validCells.empty(); i++) {
-            int index = std::rand() % validCells.size();
+            int index = rng.NextInt(static_cast<int>(validCells.size()));
             timePowerups[i].x = validCells[index].first;
             timePowerups[i].y = validCells[index].second;
             timePowerups[i].active = true;
@@ -107,7 +208,7 @@ void SpawnPowerups() {
         speedBoosts.clear();
         speedBoosts.resize(5); // Limit to 5 boosts
         for (std::vector<SpeedBoost>::size_type i = 0; i < speedBoosts.size() && !validCells.empty(); i++) {
-            int index = std::rand() % validCells.size();
+            int index = rng.NextInt(static_cast<int>(validCells.size()));
             speedBoosts[i].x = validCells[index].first;
             speedBoosts[i].y = validCells[index].second;
             speedBoosts[i].active = true;
@@ -123,7 +224,7 @@ void UpdateTimePowerups(float deltaTime) {
             
             // Check if player collected
             if (GAME_STATE.getPlayerX() == powerup.x && GAME_STATE.getPlayerY() == powerup.y) {
-                PlaySound(GameResources::bonusSound);
+                GameResources::sfx.Play(SfxId::Bonus);
                 GAME_STATE.setTimeLimit(GAME_STATE.getTimeLimit() + GAME_STATE.getTimeBonusAmount()); // Add bonus time
                 powerup.active = false;
 
@@ -144,16 +245,17 @@ void UpdateTimePowerups(float deltaTime) {
 }
 
 void DrawTimePowerups() {
+    const CellRect visible = GetVisibleCells(1);
     for (const auto& powerup : timePowerups) {
-        if (powerup.active) {
+        if (powerup.active && visible.Contains(powerup.x, powerup.y)) {
             // Calculate position
             float x = GAME_STATE.getMargin() + powerup.x * GAME_STATE.getCellSize() + GAME_STATE.getCellSize()/2.0f;
             float y = GAME_STATE.getMargin() + powerup.y * GAME_STATE.getCellSize() + GAME_STATE.getCellSize()/2.0f;
             
             // Draw with rotation
-            DrawTexturePro(
-                GameResources::timeBonusTexture,
-                Rectangle{ 0, 0, (float)GameResources::timeBonusTexture.width, (float)GameResources::timeBonusTexture.height },
+            QueueSprite(
+                SpriteId::TimeBonus,
+                0,
                 Rectangle{ x, y, GAME_STATE.getCellSize() * 0.6f, GAME_STATE.getCellSize() * 0.6f },
                 Vector2{ GAME_STATE.getCellSize() * 0.3f, GAME_STATE.getCellSize() * 0.3f },
                 powerup.rotationAngle,
@@ -177,7 +279,7 @@ void UpdateSpeedBoosts(float deltaTime) {
         if (boost.active) {
             // Check if player collected
             if (GAME_STATE.getPlayerX() == boost.x && GAME_STATE.getPlayerY() == boost.y) {
-                PlaySound(GameResources::bonusSound);
+                GameResources::sfx.Play(SfxId::Bonus);
                 GAME_STATE.setSpeedBoostTimeLeft(SPEED_BOOST_DURATION);
                 GAME_STATE.setIsSpeedBoosted(true);
                 boost.active = false;
@@ -187,14 +289,15 @@ void UpdateSpeedBoosts(float deltaTime) {
 }
 
 void DrawSpeedBoosts() {
+    const CellRect visible = GetVisibleCells(1);
     for (const auto& boost : speedBoosts) {
-        if (boost.active) {
+        if (boost.active && visible.Contains(boost.x, boost.y)) {
             float x = GAME_STATE.getMargin() + boost.x * GAME_STATE.getCellSize() + GAME_STATE.getCellSize()/2.0f;
             float y = GAME_STATE.getMargin() + boost.y * GAME_STATE.getCellSize() + GAME_STATE.getCellSize()/2.0f;
             
-            DrawTexturePro(
-                GameResources::speedBoostTexture,
-                Rectangle{ 0, 0, (float)GameResources::speedBoostTexture.width, (float)GameResources::speedBoostTexture.height },
+            QueueSprite(
+                SpriteId::SpeedBoost,
+                0,
                 Rectangle{ x, y, GAME_STATE.getCellSize() * 0.5f, GAME_STATE.getCellSize() * 0.5f },
                 Vector2{ GAME_STATE.getCellSize() * 0.2f, GAME_STATE.getCellSize() * 0.2f },
                 0,
@@ -205,7 +308,7 @@ void DrawSpeedBoosts() {
 }
 
 bool CanMove(int direction) {
-    Cell* current = &GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()];
+    const MazeGrid& grid = GAME_STATE.getGrid();
     int newX = GAME_STATE.getPlayerX(), newY = GAME_STATE.getPlayerY();
 
     // Calculate new position based on direction
@@ -218,15 +321,15 @@ bool CanMove(int direction) {
 
     // Check if the move is within bounds and not blocked by walls or obstacles
     return IsInBounds(newX, newY) && 
-           !current->walls[direction] && 
-           !GAME_STATE.getGrid()[newY][newX].isObstacle;
+           !grid.HasWall(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY(), direction) && 
+           !grid.IsObstacle(newX, newY);
 }
 
 float Lerp(float start, float end, float amount) {
     return start + amount * (end - start);
 }
 
-void MovePlayer() {
+void MovePlayer(float deltaTime) {
     if (GAME_STATE.getIsMoving()) {
         float currentSpeed = GAME_STATE.getPlayerSpeed();
         if (GAME_STATE.getIsSpeedBoosted()) {
@@ -234,7 +337,7 @@ void MovePlayer() {
         }
 
         // Update current position towards target
-        float moveAmount = currentSpeed * GetFrameTime();
+        float moveAmount = currentSpeed * deltaTime;
         GAME_STATE.setPlayerPosX(Lerp(GAME_STATE.getPlayerPosX(), GAME_STATE.getPlayerTargetX(), moveAmount));
         GAME_STATE.setPlayerPosY(Lerp(GAME_STATE.getPlayerPosY(), GAME_STATE.getPlayerTargetY(), moveAmount));
 
@@ -253,8 +356,8 @@ void MovePlayer() {
     bool shouldMove = false;
 
     if ((IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) && GAME_STATE.getPlayerY() > 0) {
-        if (!GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()].walls[0] && GAME_STATE.getGrid()[GAME_STATE.getPlayerY()-1][GAME_STATE.getPlayerX()].isObstacle) {
-            PlaySound(GameResources::blockedSound);
+        if (!GAME_STATE.getGrid().HasWall(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY(), 0) && GAME_STATE.getGrid().IsObstacle(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY()-1)) {
+            GameResources::sfx.Play(SfxId::Blocked);
         }
         else if (CanMove(0)) {
             newY--;
@@ -262,8 +365,8 @@ void MovePlayer() {
         }
     }
     else if ((IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) && GAME_STATE.getPlayerX() < GAME_STATE.getColumns() - 1) {
-        if (!GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()].walls[1] && GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()+1].isObstacle) {
-            PlaySound(GameResources::blockedSound);
+        if (!GAME_STATE.getGrid().HasWall(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY(), 1) && GAME_STATE.getGrid().IsObstacle(GAME_STATE.getPlayerX()+1, GAME_STATE.getPlayerY())) {
+            GameResources::sfx.Play(SfxId::Blocked);
         }
         else if (CanMove(1)) {
             newX++;
@@ -271,8 +374,8 @@ void MovePlayer() {
         }
     }
     else if ((IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) && GAME_STATE.getPlayerY() < GAME_STATE.getRows() - 1) {
-        if (!GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()].walls[2] && GAME_STATE.getGrid()[GAME_STATE.getPlayerY()+1][GAME_STATE.getPlayerX()].isObstacle) {
-            PlaySound(GameResources::blockedSound);
+        if (!GAME_STATE.getGrid().HasWall(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY(), 2) && GAME_STATE.getGrid().IsObstacle(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY()+1)) {
+            GameResources::sfx.Play(SfxId::Blocked);
         }
         else if (CanMove(2)) {
             newY++;
@@ -280,8 +383,8 @@ void MovePlayer() {
         }
     }
     else if ((IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) && GAME_STATE.getPlayerX() > 0) {
-        if (!GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()].walls[3] && GAME_STATE.getGrid()[GAME_STATE.getPlayerY()][GAME_STATE.getPlayerX()-1].isObstacle) {
-            PlaySound(GameResources::blockedSound);
+        if (!GAME_STATE.getGrid().HasWall(GAME_STATE.getPlayerX(), GAME_STATE.getPlayerY(), 3) && GAME_STATE.getGrid().IsObstacle(GAME_STATE.getPlayerX()-1, GAME_STATE.getPlayerY())) {
+            GameResources::sfx.Play(SfxId::Blocked);
         }
         else if (CanMove(3)) {
             newX--;
@@ -299,7 +402,7 @@ void MovePlayer() {
     }
 }
 
-void UpdatePlayerRotation() {
+void UpdatePlayerRotation(float deltaTime) {
     float diff{};
     switch (GAME_STATE.getCurrentTheme()) {
         case GameTheme::Space:
@@ -313,7 +416,7 @@ void UpdatePlayerRotation() {
             diff = GAME_STATE.getTargetRotation() - GAME_STATE.getPlayerRotation();
             if (diff > 180.0f) diff -= 360.0f;
             if (diff < -180.0f) diff += 360.0f;
-            GAME_STATE.setPlayerRotation(GAME_STATE.getPlayerRotation() + diff * GAME_STATE.getRotationSpeed() * GetFrameTime());
+            GAME_STATE.setPlayerRotation(GAME_STATE.getPlayerRotation() + diff * GAME_STATE.getRotationSpeed() * deltaTime);
         
             break;
 
@@ -323,4 +426,108 @@ void UpdatePlayerRotation() {
             GAME_STATE.setPlayerRotation(0.0f);
             break;
     }
-}
\ No newline at end of file
+}
+
+// One fixed step of gameplay; timers, win and lose all advance here rather than per rendered frame
+void SimulateTick(float deltaTime) {
+    if (GAME_STATE.getGameWon()) return;
+
+    GAME_STATE.savePreviousPlayerPose();
+    MovePlayer(deltaTime);
+    UpdatePlayerRotation(deltaTime);
+    if (GAME_STATE.getCurrentMode() == Endless) {
+        UpdateEndlessMode();
+    }
+    GAME_STATE.setTimeElapsed(GAME_STATE.getTimeElapsed() + deltaTime);
+
+    if (GAME_STATE.getCurrentMode() == Timed || GAME_STATE.getCurrentMode() == Endless) {
+        UpdateTimePowerups(deltaTime);
+    }
+    UpdateSpeedBoosts(deltaTime);
+    UpdateParticles(deltaTime);
+
+    // Check win condition
+    if (GAME_STATE.getPlayerX() == GAME_STATE.getExitX() && GAME_STATE.getPlayerY() == GAME_STATE.getExitY()) {
+        GAME_STATE.setGameWon(true);
+        GameResources::sfx.Play(SfxId::Win);
+        AddHighScore(GAME_STATE.getTimeElapsed(), GAME_STATE.getCurrentMode() == Timed);
+        GAME_STATE.setCurrentGameState(EndMenu);
+        StopCurrentThemeMusic();
+        PrefetchNextTheme();
+    }
+
+    // Check lose condition (timed and endless modes)
+    if ((GAME_STATE.getCurrentMode() == Timed || GAME_STATE.getCurrentMode() == Endless) &&
+        GAME_STATE.getTimeElapsed() >= GAME_STATE.getTimeLimit()) {
+        GAME_STATE.setGameWon(false);
+        GameResources::sfx.Play(SfxId::Lose);
+        GAME_STATE.setCurrentGameState(EndMenu);
+        StopCurrentThemeMusic();
+        PrefetchNextTheme();
+    }
+}
+
+void InitParticleEmitters() {
+    ParticleSystem& particles = GameResources::particles;
+    particles.Load(GAME_STATE.getRandom().Stream(RngStream::Effects).Split());
+
+    // Sparks streaming out of the space portal
+    EmitterSettings portal;
+    portal.rate = 1.0f / PARTICLE_SPAWN_RATE;
+    portal.lifetime = PARTICLE_MAX_LIFETIME;
+    portal.speed = PARTICLE_SPEED;
+    portal.color = SPACE_COLORS.goalColor;
+    portalEmitter = particles.AddEmitter(portal);
+
+    // Dust blowing across the desert
+    EmitterSettings dust;
+    dust.shape = EmitterShape::Area;
+    dust.rate = 150.0f;
+    dust.lifetime = 2.0f;
+    dust.lifetimeJitter = 2.0f;
+    dust.drift = Vector2{ 60.0f, 8.0f };
+    dust.jitter = Vector2{ 20.0f, 10.0f };
+    dust.size = 1.5f;
+    dust.color = Color{ 222, 184, 135, 160 };
+    dust.fadeIn = 0.5f;
+    dustEmitter = particles.AddEmitter(dust);
+
+    // Leaves drifting down through the jungle
+    EmitterSettings leaves;
+    leaves.shape = EmitterShape::Area;
+    leaves.rate = 15.0f;
+    leaves.lifetime = 4.0f;
+    leaves.lifetimeJitter = 3.0f;
+    leaves.drift = Vector2{ 10.0f, 30.0f };
+    leaves.jitter = Vector2{ 20.0f, 10.0f };
+    leaves.size = 3.0f;
+    leaves.color = Color{ 70, 150, 50, 200 };
+    leaves.fadeIn = 1.0f;
+    leafEmitter = particles.AddEmitter(leaves);
+}
+
+void UpdateParticles(float deltaTime) {
+    ParticleSystem& particles = GameResources::particles;
+    const GameTheme theme = GAME_STATE.getCurrentTheme();
+
+    // Endless mode has no exit, so no portal
+    const bool hasExit = GAME_STATE.getExitX() >= 0;
+    particles.SetEmitterActive(portalEmitter, theme == GameTheme::Space && hasExit);
+    particles.PlaceEmitter(portalEmitter,
+                           Vector2{ GAME_STATE.getMargin() + (GAME_STATE.getExitX() + 0.5f) * GAME_STATE.getCellSize(),
+                                    GAME_STATE.getMargin() + (GAME_STATE.getExitY() + 0.5f) * GAME_STATE.getCellSize() },
+                           GAME_STATE.getCellSize() / 2.0f);
+
+    // Ambient particles only need to fill what the camera sees
+    const Rectangle view = GetCameraView();
+    particles.SetEmitterActive(dustEmitter, theme == GameTheme::Desert);
+    particles.PlaceEmitter(dustEmitter, view);
+    particles.SetEmitterActive(leafEmitter, theme == GameTheme::Jungle);
+    particles.PlaceEmitter(leafEmitter, view);
+
+    particles.Update(deltaTime);
+}
+
+void DrawParticles() {
+    GameResources::particles.Draw(GetCameraView());
+}
@@ -0,0 +1,178 @@
+#include "hud_text.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <utility>
+
+namespace {
+    const int GLYPH_COUNT = sizeof(HUD_GLYPHS) - 1;
+
+    struct Label {
+        Texture2D texture;
+        unsigned long long lastUsed;    // Frame it was last drawn or measured in
+    };
+    // Keyed by font size, then text
+    std::map<std::pair<int, std::string>, Label> labels;
+    unsigned long long frame = 0;
+
+    // HUD_GLYPHS side by side at one font size
+    struct GlyphStrip {
+        Texture2D texture = {0};
+        Rectangle glyphs[GLYPH_COUNT];
+    };
+    std::map<int, GlyphStrip> strips;
+
+    // Renders through DrawText itself so cached text matches it pixel for
+    // pixel, then copies the result into a plain texture and frees the target.
+    // Uses texture mode, so it must not run inside BeginMode2D.
+    template <typename DrawFunction>
+    Texture2D Rasterize(int width, int height, DrawFunction draw) {
+        RenderTexture2D target = LoadRenderTexture(width, height);
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        draw();
+        EndTextureMode();
+
+        Image image = LoadImageFromTexture(target.texture);
+        ImageFlipVertical(&image);
+        Texture2D texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        UnloadRenderTexture(target);
+        return texture;
+    }
+
+    void UnloadLabels() {
+        for (auto& entry : labels) UnloadTexture(entry.second.texture);
+        labels.clear();
+    }
+
+    // Never evicts: quads drawn earlier this frame may still sit in the
+    // render batch, so the cache is only trimmed in HudText::EndFrame()
+    const Texture2D& GetLabel(const char* text, int fontSize) {
+        auto key = std::make_pair(fontSize, std::string(text));
+        auto found = labels.find(key);
+        if (found == labels.end()) {
+            Texture2D texture = Rasterize(MeasureText(text, fontSize), fontSize,
+                                          [&]() { DrawText(text, 0, 0, fontSize, WHITE); });
+            found = labels.emplace(key, Label{ texture, frame }).first;
+        }
+        found->second.lastUsed = frame;
+        return found->second.texture;
+    }
+
+    const GlyphStrip& GetStrip(int fontSize) {
+        auto found = strips.find(fontSize);
+        if (found != strips.end()) return found->second;
+
+        // One pixel between glyphs keeps them from bleeding into each other
+        GlyphStrip strip;
+        int width = 0;
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            const char glyph[2] = { HUD_GLYPHS[i], '\0' };
+            const int glyphWidth = MeasureText(glyph, fontSize);
+            strip.glyphs[i] = Rectangle{ static_cast<float>(width), 0, static_cast<float>(glyphWidth),
+                                         static_cast<float>(fontSize) };
+            width += glyphWidth + 1;
+        }
+        strip.texture = Rasterize(width, fontSize, [&]() {
+            for (int i = 0; i < GLYPH_COUNT; i++) {
+                const char glyph[2] = { HUD_GLYPHS[i], '\0' };
+                DrawText(glyph, static_cast<int>(strip.glyphs[i].x), 0, fontSize, WHITE);
+            }
+        });
+        return strips.emplace(fontSize, strip).first->second;
+    }
+}
+
+namespace HudText {
+    void DrawLabel(const char* text, int x, int y, int fontSize, Color color) {
+        if (text[0] == '\0') return;
+        DrawTexture(GetLabel(text, fontSize), x, y, color);
+    }
+
+    void DrawLabelCentered(const char* text, int centerX, int y, int fontSize, Color color) {
+        if (text[0] == '\0') return;
+        const Texture2D& label = GetLabel(text, fontSize);
+        DrawTexture(label, centerX - label.width / 2, y, color);
+    }
+
+    int MeasureLabel(const char* text, int fontSize) {
+        if (text[0] == '\0') return 0;
+        return GetLabel(text, fontSize).width;
+    }
+
+    int GetSpacing(int fontSize) {
+        // DrawText scales the 10px default font and spaces glyphs by the same factor
+        return std::max(fontSize, 10) / 10;
+    }
+
+    void EndFrame() {
+        frame++;
+        const size_t excess = labels.size() > static_cast<size_t>(HUD_MAX_LABELS) ? labels.size() - HUD_MAX_LABELS : 0;
+        if (excess == 0) return;
+
+        // Labels built from changing text (timers, score rows) would otherwise
+        // pile up; the least recently used go first
+        std::vector<decltype(labels)::iterator> byAge;
+        for (auto it = labels.begin(); it != labels.end(); ++it) byAge.push_back(it);
+        std::nth_element(byAge.begin(), byAge.begin() + (excess - 1), byAge.end(),
+                         [](const auto& a, const auto& b) { return a->second.lastUsed < b->second.lastUsed; });
+        for (size_t i = 0; i < excess; i++) {
+            UnloadTexture(byAge[i]->second.texture);
+            labels.erase(byAge[i]);
+        }
+    }
+
+    void Unload() {
+        UnloadLabels();
+        for (auto& entry : strips) UnloadTexture(entry.second.texture);
+        strips.clear();
+    }
+}
+
+HudNumber::HudNumber(const char* prefix, int decimals, int fontSize, const char* suffix)
+    : m_prefix(prefix), m_suffix(suffix), m_decimals(decimals), m_fontSize(fontSize) {}
+
+void HudNumber::Set(double value) {
+    const double scale = std::pow(10.0, m_decimals);
+    const long long shown = std::llround(value * scale);
+    if (m_laidOut && shown == m_shown) return;
+    m_shown = shown;
+    m_laidOut = true;
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.*f", m_decimals, shown / scale);
+
+    const GlyphStrip& strip = GetStrip(m_fontSize);
+    const int spacing = HudText::GetSpacing(m_fontSize);
+    int x = m_prefix.empty() ? 0 : HudText::MeasureLabel(m_prefix.c_str(), m_fontSize) + spacing;
+    m_digitsX = x;
+
+    m_glyphs.clear();
+    for (const char* c = text; *c != '\0'; c++) {
+        const char* glyph = std::strchr(HUD_GLYPHS, *c);
+        if (glyph == nullptr) continue;
+        const int index = static_cast<int>(glyph - HUD_GLYPHS);
+        m_glyphs.push_back(index);
+        x += static_cast<int>(strip.glyphs[index].width) + spacing;
+    }
+
+    m_suffixX = x;
+    m_width = m_suffix.empty() ? x - spacing : x + HudText::MeasureLabel(m_suffix.c_str(), m_fontSize);
+}
+
+void HudNumber::Draw(int x, int y, Color color) const {
+    HudText::DrawLabel(m_prefix.c_str(), x, y, m_fontSize, color);
+
+    const GlyphStrip& strip = GetStrip(m_fontSize);
+    const int spacing = HudText::GetSpacing(m_fontSize);
+    float glyphX = static_cast<float>(x + m_digitsX);
+    for (int index : m_glyphs) {
+        DrawTextureRec(strip.texture, strip.glyphs[index], Vector2{ glyphX, static_cast<float>(y) }, color);
+        glyphX += strip.glyphs[index].width + spacing;
+    }
+
+    HudText::DrawLabel(m_suffix.c_str(), x + m_suffixX, y, m_fontSize, color);
+}
@@ -0,0 +1,54 @@
+#ifndef HUD_TEXT_H
+#define HUD_TEXT_H
+
+#include <string>
+#include <vector>
+#include "raylib.h"
+
+// Characters a HudNumber can show
+const char HUD_GLYPHS[] = "0123456789.:+-";
+// Cached labels past this count are dropped, least recently used first, at the
+// end of the frame and rasterized again on demand
+const int HUD_MAX_LABELS = 256;
+
+// Text drawing without per-frame formatting or glyph layout. Labels are
+// rasterized once per (text, size) with the default font into a white
+// texture and tinted when drawn, so colour changes cost nothing.
+namespace HudText {
+    void DrawLabel(const char* text, int x, int y, int fontSize, Color color);
+    void DrawLabelCentered(const char* text, int centerX, int y, int fontSize, Color color);
+    int MeasureLabel(const char* text, int fontSize);
+    // Gap DrawText leaves between glyphs at this size
+    int GetSpacing(int fontSize);
+    // Call after EndDrawing(); trims the label cache once nothing pending can use it
+    void EndFrame();
+    void Unload();
+}
+
+// A label followed by a number, e.g. "Time Left: 42.17". The digits come from
+// one glyph strip per font size and are only laid out again when the value,
+// rounded to the shown decimals, changes.
+class HudNumber {
+public:
+    HudNumber(const char* prefix, int decimals, int fontSize, const char* suffix = "");
+
+    void Set(double value);
+    void Draw(int x, int y, Color color) const;
+    // Whole field including prefix and suffix, as MeasureText would report it
+    int getWidth() const { return m_width; }
+
+private:
+    std::string m_prefix;
+    std::string m_suffix;
+    int m_decimals;
+    int m_fontSize;
+    long long m_shown = 0;
+    bool m_laidOut = false;
+
+    std::vector<int> m_glyphs;      // Indices into HUD_GLYPHS
+    int m_digitsX = 0;              // Where the digits start, relative to the field
+    int m_suffixX = 0;
+    int m_width = 0;
+};
+
+#endif
@@ -3,22 +3,88 @@
 #include "resources.h"
 #include "maze.h"
 #include "gameplay.h"
+#include "maze_layer.h"
+#include "maze_shader.h"
+#include "star_field.h"
+#include "render_scale.h"
+#include "asset_archive.h"
 #include "ui.h"
+#include "hud_text.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 bool isPaused = false;
-float pauseStartTime = 0.0f;
-RenderTexture2D mazeRenderTexture;
-Texture2D starFieldTexture;
+float tickAccumulator = 0.0f;   // Frame time not yet consumed by simulation ticks
+MazeLayer mazeLayer;
+MazeShaderLayer mazeShaderLayer;
+StarField starField;
+DynamicResolution dynamicResolution;
 
-int main()
+int main(int argc, char* argv[])
 {
-    // Initialize window
+    // --seed <n> makes the whole session (mazes, themes, effects) reproducible
+    // --maze <W>x<H> fixes the maze size in cells (at least 8x8); larger mazes scroll with the player
+    // --tiled carves each maze in independent tiles on all cores (GenerationMode::Parallel)
+    // --shader-maze starts on the single-pass shader maze renderer (F4 toggles it)
+    // --fps <n> caps rendering at n frames per second; 0 (default) leaves it to vsync
+    // --adaptive-res scales the playfield resolution to hold the frame budget (F5 toggles it)
+    // --frame-budget <ms> sets that budget; the default is one 60 Hz frame
+    // --assets <file> reads assets from that archive instead of assets.pak
+    // --vram-budget <MiB> / --ram-budget <MiB> size the cache of released textures and sounds
+    int targetFps = 0;
+    const char* assetArchive = ASSET_ARCHIVE_FILE;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--shader-maze") == 0) {
+            GAME_STATE.setUseShaderMaze(true);
+        } else if (std::strcmp(argv[i], "--adaptive-res") == 0) {
+            GAME_STATE.setUseAdaptiveResolution(true);
+        } else if (hasValue && std::strcmp(argv[i], "--frame-budget") == 0) {
+            const float budgetMs = static_cast<float>(std::atof(argv[i + 1]));
+            if (budgetMs > 0.0f) dynamicResolution.setBudgetMs(budgetMs);
+        } else if (hasValue && std::strcmp(argv[i], "--seed") == 0) {
+            GAME_STATE.getRandom().SeedSession(std::strtoull(argv[i + 1], nullptr, 10));
+        } else if (hasValue && std::strcmp(argv[i], "--maze") == 0) {
+            int columns = 0, rows = 0;
+            if (std::sscanf(argv[i + 1], "%dx%d", &columns, &rows) == 2) {
+                GAME_STATE.setMazeDimensions(std::max(columns, MIN_MAZE_SIZE), std::max(rows, MIN_MAZE_SIZE));
+            }
+        } else if (std::strcmp(argv[i], "--tiled") == 0) {
+            GAME_STATE.setGenerationMode(GenerationMode::Parallel);
+        } else if (hasValue && std::strcmp(argv[i], "--assets") == 0) {
+            assetArchive = argv[i + 1];
+        } else if (hasValue && std::strcmp(argv[i], "--vram-budget") == 0) {
+            ResourceManager& manager = GameResources::resourceManager;
+            manager.SetBudget(static_cast<size_t>(std::max(std::atoi(argv[i + 1]), 0)) << 20, manager.getRamBudget());
+        } else if (hasValue && std::strcmp(argv[i], "--ram-budget") == 0) {
+            ResourceManager& manager = GameResources::resourceManager;
+            manager.SetBudget(manager.getVramBudget(), static_cast<size_t>(std::max(std::atoi(argv[i + 1]), 0)) << 20);
+        } else if (hasValue && std::strcmp(argv[i], "--fps") == 0) {
+            targetFps = std::max(std::atoi(argv[i + 1]), 0);
+        }
+    }
+
+    // Initialize window; the simulation runs on fixed ticks, so the render rate is free
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight(), "Portal Paths: Maze Multiverse");
-    SetTargetFPS(60);
+    SetTargetFPS(targetFps);
+
+    // Needs the GL context; without GLSL 330 the cached chunk renderer is used
+    mazeShaderLayer.Load();
+    starField.Load();
+    InitParticleEmitters();
 
     // Initialize audio
     InitAudioDevice();
 
+    // One mapped archive instead of a file open per asset, when it is there
+    GameResources::OpenAssetArchive(assetArchive);
+
+    // Drawn in place of theme sprites that are still streaming in
+    GameResources::LoadFallbackSprites();
     RandomizeTheme();
 
     // Load initial resources
@@ -26,25 +92,29 @@ int main()
     GameResources::LoadPowerupResources();
     SetThemeResources(GAME_STATE.getCurrentTheme());
 
-    // Load star field texture
-    if (GAME_STATE.getCurrentTheme() == GameTheme::Space)
-    {
-        starFieldTexture = CreateStarFieldTexture(GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight(), 200);
-    }
-
     // Load high scores
     LoadHighScores();
 
     // Main game loop
+    double lastFrameStart = GetTime();
     while (!WindowShouldClose())
     {
+        // Wall-clock length of the whole previous loop, presentation and vsync wait included
+        const double frameStart = GetTime();
+        const float frameTime = static_cast<float>(frameStart - lastFrameStart);
+        lastFrameStart = frameStart;
+
+        // Finish decoded theme assets and upload the next slice of a streaming atlas
+        GameResources::UpdateStreaming();
+
         BeginDrawing();
         ClearBackground(GAME_STATE.getCurrentColors().background);
 
-        // Draw star field background for space theme
-        if (GAME_STATE.getCurrentTheme() == GameTheme::Space)
+        // Draw star field background for space theme; the adaptive playfield draws its own at its resolution
+        const bool scaledPlayfield = GAME_STATE.getCurrentGameState() == Playing && !isPaused && GAME_STATE.getUseAdaptiveResolution();
+        if (GAME_STATE.getCurrentTheme() == GameTheme::Space && !scaledPlayfield)
         {
-            DrawTexture(starFieldTexture, 0, 0, WHITE);
+            starField.Draw(GAME_STATE.getCamera(), GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight());
         }
 
         // Update music streams
@@ -79,18 +149,6 @@ int main()
             }
         }
 
-        // Handle player rotation based on theme
-        switch (GAME_STATE.getCurrentTheme())
-        {
-        case GameTheme::Space:
-            UpdatePlayerRotation();
-            break;
-        case GameTheme::Jungle:
-        case GameTheme::Desert:
-            GAME_STATE.setPlayerRotation(0.0f);
-            break;
-        }
-
         // Game state machine
         switch (GAME_STATE.getCurrentGameState())
         {
@@ -99,80 +157,46 @@ int main()
             break;
 
         case Playing:
+            if (IsKeyPressed(KEY_F3))
+            {
+                GAME_STATE.setShowDebugOverlay(!GAME_STATE.getShowDebugOverlay());
+            }
+
+            if (IsKeyPressed(KEY_F4))
+            {
+                GAME_STATE.setUseShaderMaze(!GAME_STATE.getUseShaderMaze());
+            }
+
+            if (IsKeyPressed(KEY_F5))
+            {
+                GAME_STATE.setUseAdaptiveResolution(!GAME_STATE.getUseAdaptiveResolution());
+                dynamicResolution.Reset();
+            }
+
             if (IsKeyPressed(KEY_P))
             {
                 if (!isPaused)
                 {
                     isPaused = true;
-                    pauseStartTime = GetTime();
                     StopCurrentThemeMusic();
                 }
                 else
                 {
                     isPaused = false;
-                    GAME_STATE.setTotalPausedTime(GAME_STATE.getTotalPausedTime() + GetTime() - pauseStartTime);
                     SetThemeResources(GAME_STATE.getCurrentTheme());
                 }
             }
 
             if (!isPaused)
             {
-                if (!GAME_STATE.getGameWon())
+                // Run as many fixed ticks as the frame time covers, then blend the rest
+                tickAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+                while (tickAccumulator >= SIM_TICK && GAME_STATE.getCurrentGameState() == Playing)
                 {
-                    MovePlayer();
-                    UpdatePlayerRotation();
-                    GAME_STATE.setTimeElapsed(GetTime() - GAME_STATE.getStartTime() - GAME_STATE.getTotalPausedTime());
-
-                    if (GAME_STATE.getCurrentMode() == Timed)
-                    {
-                        UpdateTimePowerups(GetFrameTime());
-                        DrawTimePowerups();
-
-                        if (GAME_STATE.getShowTimeBonusFeedback())
-                        {
-                            // Draw Time Left and Time Bonus at distinct positions
-                            float timeLeft = GAME_STATE.getTimeLimit() - GAME_STATE.getTimeElapsed();
-                            std::string timeText = TextFormat("Time Left: %.2f", timeLeft);
-                            std::string bonusText = TextFormat(" + %.1f", GAME_STATE.getTimeBonusAmount());
-
-                            DrawText(timeText.c_str(), 10, 8, 20, WHITE);
-                            DrawText(bonusText.c_str(), 10 + MeasureText(timeText.c_str(), 20), 8, 20, GREEN); // Positioned next the main timer
-                        }
-                        else
-                        {
-                            float timeLeft = GAME_STATE.getTimeLimit() - GAME_STATE.getTimeElapsed();
-                            Color timeColor = (timeLeft < 10.0f) ? RED : WHITE;
-                            std::string timeText = TextFormat("Time Left: %.2f", timeLeft);
-                            DrawText(timeText.c_str(), 10, 8, 20, timeColor);
-                        }
-                    }
-                    else
-                    {
-                        DrawText(TextFormat("Time: %.2f", GAME_STATE.getTimeElapsed()), 10, 8, 20, WHITE); // Draw timer
-                    }
-
-                    UpdateSpeedBoosts(GetFrameTime());
-                    DrawSpeedBoosts();
-
-                    // Check win condition
-                    if (GAME_STATE.getPlayerX() == GAME_STATE.getExitX() && GAME_STATE.getPlayerY() == GAME_STATE.getExitY())
-                    {
-                        GAME_STATE.setGameWon(true);
-                        PlaySound(GameResources::winSound);
-                        AddHighScore(GAME_STATE.getTimeElapsed(), GAME_STATE.getCurrentMode() == Timed);
-                        GAME_STATE.setCurrentGameState(EndMenu);
-                        StopCurrentThemeMusic();
-                    }
-
-                    // Check lose condition (timed mode)
-                    if (GAME_STATE.getCurrentMode() == Timed && GAME_STATE.getTimeElapsed() >= GAME_STATE.getTimeLimit())
-                    {
-                        GAME_STATE.setGameWon(false);
-                        PlaySound(GameResources::loseSound);
-                        GAME_STATE.setCurrentGameState(EndMenu);
-                        StopCurrentThemeMusic();
-                    }
+                    SimulateTick(SIM_TICK);
+                    tickAccumulator -= SIM_TICK;
                 }
+                GAME_STATE.setTickAlpha(tickAccumulator / SIM_TICK);
             }
             else
             {
@@ -191,81 +215,134 @@ int main()
 
             if (!isPaused)
             {
-                // Draw maze and border
-                DrawBorder();
-                for (const auto &row : GAME_STATE.getGrid())
+                // Only what intersects the camera view is rendered from here on
+                FollowPlayerCamera();
+                const CellRect visible = GetVisibleCells();
+
+                // Maze chunks (or the shader's cell texture) are cached; refreshed only after the maze or theme changed
+                const bool useShaderMaze = GAME_STATE.getUseShaderMaze() && mazeShaderLayer.IsReady();
+                if (GAME_STATE.getMazeLayerDirty())
                 {
-                    for (const auto &cell : row)
+                    mazeLayer.Invalidate();
+                    mazeShaderLayer.Invalidate();
+                    GAME_STATE.setMazeLayerDirty(false);
+                }
+                if (useShaderMaze)
+                    mazeShaderLayer.Update();
+                else
+                    mazeLayer.Update(visible);
+
+                // The adaptive playfield goes through a scaled render target; the updates
+                // above use texture mode themselves, so this has to come after them
+                const bool useAdaptiveResolution = GAME_STATE.getUseAdaptiveResolution();
+                Camera2D playfieldCamera = GAME_STATE.getCamera();
+                if (useAdaptiveResolution)
+                {
+                    dynamicResolution.Update(frameTime);
+                    playfieldCamera = dynamicResolution.Begin(playfieldCamera, GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight());
+                    ClearBackground(GAME_STATE.getCurrentColors().background);
+                    if (GAME_STATE.getCurrentTheme() == GameTheme::Space)
                     {
-                        cell.Draw();
+                        starField.Draw(GAME_STATE.getCamera(), GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight(),
+                                       dynamicResolution.getScale());
                     }
                 }
 
-                // Draw pause hint in top-right corner
-                const char *pauseHint = "P - Pause/Settings";
-                DrawText(pauseHint,
-                         GAME_STATE.getScreenWidth() - MeasureText(pauseHint, 20) - 10,
-                         8, 20, LIGHTGRAY);
+                BeginMode2D(playfieldCamera);
+                DrawBorder();
+                if (useShaderMaze)
+                    mazeShaderLayer.Draw(visible);
+                else
+                    mazeLayer.Draw(visible);
+
+                // Draw powerups (queued on the sprite batch, one flush for the atlas)
+                DrawTimePowerups();
+                DrawSpeedBoosts();
+                GameResources::spriteBatch.Flush();
 
-                // Draw powerups
-                if (GAME_STATE.getCurrentMode() == Timed)
+                // Draw exit (endless mode marks the next depth milestone instead)
+                if (GAME_STATE.getCurrentMode() == Endless)
                 {
-                    DrawTimePowerups();
-                    DrawSpeedBoosts();
+                    DrawEndlessMilestone();
                 }
-
-                // Draw exit
-                DrawExit(GAME_STATE.getExitX(), GAME_STATE.getExitY(), GetTime() - GAME_STATE.getStartTime());
+                else
+                {
+                    DrawExit(GAME_STATE.getExitX(), GAME_STATE.getExitY(), GetTime() - GAME_STATE.getStartTime());
+                }
+                DrawParticles();
 
                 // Draw player based on theme
                 if (GAME_STATE.getCurrentTheme() == GameTheme::Space)
                 {
                     // Space theme uses rotation
-                    DrawTexturePro(
-                        GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()),
-                        Rectangle{0, 0,
-                                  (float)GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()).width,
-                                  (float)GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()).height},
+                    DrawSprite(
+                        SpriteId::Player,
                         Rectangle{
-                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getPlayerPosX() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
-                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getPlayerPosY() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
+                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getRenderPlayerPosX() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
+                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getRenderPlayerPosY() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
                             GAME_STATE.getCellSize() * 0.8f,
                             GAME_STATE.getCellSize() * 0.8f},
                         Vector2{GAME_STATE.getCellSize() * 0.4f, GAME_STATE.getCellSize() * 0.4f},
-                        GAME_STATE.getPlayerRotation(),
+                        GAME_STATE.getRenderPlayerRotation(),
                         GAME_STATE.getCurrentColors().playerTint);
                 }
                 else
                 {
                     // Jungle and Desert themes use horizontal flipping
-                    DrawTexturePro(
-                        GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()),
-                        Rectangle{0, 0,
-                                  (float)GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()).width * (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A) ? -1.0f : 1.0f), // Flip horizontally for left movement
-                                  (float)GetPlayerTextureForTheme(GAME_STATE.getCurrentTheme()).height},
+                    DrawSprite(
+                        SpriteId::Player,
                         Rectangle{
-                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getPlayerPosX() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
-                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getPlayerPosY() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
+                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getRenderPlayerPosX() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
+                            static_cast<float>(GAME_STATE.getMargin()) + GAME_STATE.getRenderPlayerPosY() * GAME_STATE.getCellSize() + GAME_STATE.getCellSize() / 2,
                             GAME_STATE.getCellSize() * 0.8f,
                             GAME_STATE.getCellSize() * 0.8f},
                         Vector2{GAME_STATE.getCellSize() * 0.4f, GAME_STATE.getCellSize() * 0.4f}, // Origin at center
-                        GAME_STATE.getPlayerRotation(),
-                        GAME_STATE.getCurrentColors().playerTint);
+                        GAME_STATE.getRenderPlayerRotation(),
+                        GAME_STATE.getCurrentColors().playerTint,
+                        IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)); // Flip horizontally for left movement
                 }
+                EndMode2D();
+                if (useAdaptiveResolution)
+                    dynamicResolution.End();
+
+                // Timer, pause hint and speed boost, always at window resolution
+                DrawPlayingHud();
 
-                // Draw UI elements
-                if (GAME_STATE.getIsSpeedBoosted())
+                if (GAME_STATE.getShowDebugOverlay())
                 {
-                    DrawText(TextFormat("Speed Boost: %.2fs", GAME_STATE.getSpeedBoostTimeLeft()),
-                             900, 8, 20, YELLOW);
+                    mazeLayer.DrawDebugOverlay();
+                    DrawText(useShaderMaze ? TextFormat("Maze renderer: shader (F4), %d cells uploaded last sync",
+                                                        mazeShaderLayer.getLastUploadCells())
+                                           : "Maze renderer: cached chunks (F4)",
+                             10, GAME_STATE.getScreenHeight() - 135, 18, LIGHTGRAY);
+                    DrawText(TextFormat("Particles: %d live, %.3f ms update", GameResources::particles.getCount(),
+                                        GameResources::particles.getLastUpdateMs()),
+                             10, GAME_STATE.getScreenHeight() - 160, 18, LIGHTGRAY);
+                    DrawText(useAdaptiveResolution
+                                 ? TextFormat("Render scale: %d%% (F5), budget %.1f ms, frame avg %.1f ms",
+                                              static_cast<int>(std::lround(dynamicResolution.getScale() * 100)),
+                                              dynamicResolution.getBudgetMs(), dynamicResolution.getAverageFrameMs())
+                                 : TextFormat("Render scale: native (F5), budget %.1f ms", dynamicResolution.getBudgetMs()),
+                             10, GAME_STATE.getScreenHeight() - 185, 18, LIGHTGRAY);
+                    const ResourceManager& manager = GameResources::resourceManager;
+                    const ResourceStats& stats = manager.getStats();
+                    DrawText(TextFormat("Resources: %d resident (%d in use), VRAM %.1f/%.0f MB, RAM %.1f/%.0f MB, "
+                                        "%lld hits, %lld misses, %lld evictions",
+                                        stats.resident, stats.referenced, stats.vramBytes / 1048576.0,
+                                        manager.getVramBudget() / 1048576.0, stats.ramBytes / 1048576.0,
+                                        manager.getRamBudget() / 1048576.0, stats.hits, stats.misses, stats.evictions),
+                             10, GAME_STATE.getScreenHeight() - 210, 18, LIGHTGRAY);
+                    const SfxStats& sfxStats = GameResources::sfx.getStats();
+                    DrawText(TextFormat("Sound effects: %d/%d voices, %lld played, %lld dropped (%lld throttled), %lld stolen",
+                                        GameResources::sfx.getActiveVoices(), GameResources::sfx.getMaxVoices(),
+                                        sfxStats.played, sfxStats.dropped, sfxStats.throttled, sfxStats.stolen),
+                             10, GAME_STATE.getScreenHeight() - 235, 18, LIGHTGRAY);
                 }
             }
             else
             {
                 DrawPauseMenu();
             }
-
-            EndDrawing();
             break;
 
         case EndMenu:
@@ -294,13 +371,16 @@ int main()
             break;
         }
         EndDrawing();
+        HudText::EndFrame();
     }
 
     // Cleanup
-    if (GAME_STATE.getCurrentTheme() == GameTheme::Space)
-    {
-        UnloadTexture(starFieldTexture);
-    }
+    starField.Unload();
+    dynamicResolution.Unload();
+    mazeLayer.Unload();
+    mazeShaderLayer.Unload();
+    GameResources::particles.Unload();
+    HudText::Unload();
     GameResources::UnloadAllResources();
     CloseAudioDevice();
     CloseWindow();
@@ -2,10 +2,10 @@
 #define MAZE_H
 
 #include <vector>
-#include <stack>
 #include "raylib.h"
 #include "game_state.h"
 #include "resources.h"
+#include "maze_builder.h"
 
 // Desert obstacle types
 enum class DesertObstacleType {
@@ -21,27 +21,22 @@ const int directions[4][2] = {
     {-1, 0}   // Left
 };
 
-// Cell structure
+// Lightweight handle to a cell stored in GAME_STATE.getGrid()
 struct Cell {
     int x, y;
-    bool visited;
-    bool walls[4]; // Top, Right, Bottom, Left
-    bool isObstacle;
-    int spriteRow;
-    int spriteCol;
-    int logSpriteRow;
-    int logSpriteCol;
-    DesertObstacleType desertObstacleType;
 
-    Cell(int x_, int y_);
+    Cell(int x_ = 0, int y_ = 0);
+    bool HasWall(int direction) const;
+    bool IsObstacle() const;
+    DesertObstacleType GetDesertObstacleType() const;
     void Draw() const;
 };
 
 void InitializeGrid();
 bool IsInBounds(int x, int y);
-Cell* GetUnvisitedNeighbor(Cell* current);
-void RemoveWalls(Cell* current, Cell* next);
 void GenerateMaze();
+void GenerateMazeSerial();
+void GenerateMazeParallel(int tileSize = GENERATION_TILE_SIZE);
 void DrawBorder();
 void PlaceRandomExit();
 void DrawExit(int exitX, int exitY, float time);
@@ -0,0 +1,195 @@
+#include "maze_builder.h"
+#include "obstacle_placer.h"
+#include <algorithm>
+#include <random>
+
+MazeRules MazeRules::Get(Difficulty diff) {
+    switch(diff) {
+        case Easy:
+            return {0.15f, MazeAlgorithm::Backtracker, ExitPlacement::Random};
+        case Medium:
+            return {0.20f, MazeAlgorithm::Backtracker, ExitPlacement::Random};
+        case Hard:
+            return {0.25f, MazeAlgorithm::Backtracker, ExitPlacement::Farthest};
+        default:
+            return {0.15f, MazeAlgorithm::Backtracker, ExitPlacement::Random};
+    }
+}
+
+void CarveMaze(MazeGrid& grid, MazeGenerator& generator, Xoshiro256& rng) {
+    generator.Generate(grid, MazeRegion{0, 0, grid.getColumns(), grid.getRows()}, rng);
+}
+
+// Every tile becomes a perfect maze on its own, then a random spanning tree over
+// the tile graph opens exactly one door per tree edge, so the whole grid is
+// still a perfect maze
+void CarveMazeTiled(MazeGrid& grid, MazeAlgorithm algorithm, int tileSize, Xoshiro256& rng) {
+    const int cols = grid.getColumns();
+    const int rows = grid.getRows();
+    const int tilesX = (cols + tileSize - 1) / tileSize;
+    const int tilesY = (rows + tileSize - 1) / tileSize;
+    const int tileCount = tilesX * tilesY;
+
+    // One substream per tile, handed out up front so the layout depends only on
+    // the maze seed and not on which thread happens to carve which tile
+    std::vector<Xoshiro256> tileRngs;
+    tileRngs.reserve(tileCount);
+    for (int tile = 0; tile < tileCount; ++tile) tileRngs.push_back(rng.Split());
+
+    #pragma omp parallel
+    {
+        std::unique_ptr<MazeGenerator> generator = CreateMazeGenerator(algorithm);
+
+        #pragma omp for schedule(dynamic)
+        for (int tile = 0; tile < tileCount; ++tile) {
+            int tx = tile % tilesX;
+            int ty = tile / tilesX;
+            MazeRegion region{tx * tileSize, ty * tileSize,
+                              std::min(cols, (tx + 1) * tileSize), std::min(rows, (ty + 1) * tileSize)};
+            generator->Generate(grid, region, tileRngs[tile]);
+        }
+    }
+
+    // Stitch tiles with a randomized DFS spanning tree over the tile graph
+    std::vector<bool> tileVisited(tileCount, false);
+    std::vector<int> tileStack;
+    tileStack.reserve(tileCount);
+    tileVisited[0] = true;
+    tileStack.push_back(0);
+
+    while (!tileStack.empty()) {
+        int tx = tileStack.back() % tilesX;
+        int ty = tileStack.back() / tilesX;
+
+        int candidates[4];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            int nx = tx + DIRECTION_DX[i];
+            int ny = ty + DIRECTION_DY[i];
+            if (nx >= 0 && nx < tilesX && ny >= 0 && ny < tilesY && !tileVisited[ny * tilesX + nx]) {
+                candidates[count++] = i;
+            }
+        }
+
+        if (count == 0) {
+            tileStack.pop_back();
+            continue;
+        }
+
+        int direction = candidates[rng.NextInt(count)];
+        int nx = tx + DIRECTION_DX[direction];
+        int ny = ty + DIRECTION_DY[direction];
+
+        // Open one door at a random spot along the shared border
+        if (DIRECTION_DX[direction] != 0) {
+            int x = direction == 1 ? std::min(cols, (tx + 1) * tileSize) - 1 : tx * tileSize;
+            int y0 = ty * tileSize;
+            int y1 = std::min(rows, (ty + 1) * tileSize);
+            grid.RemoveWall(x, y0 + rng.NextInt(y1 - y0), direction);
+        } else {
+            int y = direction == 2 ? std::min(rows, (ty + 1) * tileSize) - 1 : ty * tileSize;
+            int x0 = tx * tileSize;
+            int x1 = std::min(cols, (tx + 1) * tileSize);
+            grid.RemoveWall(x0 + rng.NextInt(x1 - x0), y, direction);
+        }
+
+        tileVisited[ny * tilesX + nx] = true;
+        tileStack.push_back(ny * tilesX + nx);
+    }
+}
+
+// One BFS over the exit candidates instead of an A* per rejected sample
+int ChooseExit(const MazeGrid& grid, MazeSolver& solver, ExitPlacement placement, Xoshiro256& rng) {
+    solver.FloodFill(grid, 0, 0);
+
+    // Keep exit away from start position (minimum distance)
+    const int MIN_DISTANCE = std::max(grid.getColumns(), grid.getRows()) / 2;
+
+    std::vector<int> candidates;
+    int farthest = grid.Index(0, 0);
+    for (int y = 0; y < grid.getRows(); y++) {
+        for (int x = 0; x < grid.getColumns(); x++) {
+            int index = grid.Index(x, y);
+            if (solver.Distance(index) < 0 || grid.IsObstacle(x, y)) continue;
+
+            if (solver.Distance(index) > solver.Distance(farthest)) farthest = index;
+            if (x + y >= MIN_DISTANCE) candidates.push_back(index);
+        }
+    }
+
+    int exitIndex = farthest;
+    if (placement == ExitPlacement::Random && !candidates.empty()) {
+        exitIndex = candidates[rng.NextInt(static_cast<int>(candidates.size()))];
+    } else if (placement == ExitPlacement::DistanceWeighted && !candidates.empty()) {
+        long long totalWeight = 0;
+        for (int index : candidates) totalWeight += solver.Distance(index);
+
+        long long pick = std::uniform_int_distribution<long long>(0, totalWeight - 1)(rng);
+        for (int index : candidates) {
+            pick -= solver.Distance(index);
+            if (pick < 0) { exitIndex = index; break; }
+        }
+    }
+    return exitIndex;
+}
+
+int ScatterObstacles(MazeGrid& grid, MazeSolver& solver, int exitX, int exitY, float percentage, Xoshiro256& rng) {
+    ObstaclePlacer placer(grid, solver, 0, 0, exitX, exitY);
+    if (!placer.HasPath()) return 0;
+
+    // Cells an obstacle can take: not start or exit, not already blocked, and
+    // not on the route when the maze is perfect (that route has no detour)
+    int available = 0;
+    for (int y = 0; y < grid.getRows(); y++) {
+        for (int x = 0; x < grid.getColumns(); x++) {
+            if ((x == 0 && y == 0) || (x == exitX && y == exitY) || grid.IsObstacle(x, y)) continue;
+            if (placer.IsPerfectMaze() && placer.IsOnPath(x, y)) continue;
+            available++;
+        }
+    }
+
+    // The difficulty's share of cells, capped so small mazes with a long route can still be filled
+    int maxObstacles = std::min(std::max(1, static_cast<int>(grid.getCellCount() * percentage)), available);
+    int obstacleCount = 0;
+
+    // On other mazes on-path candidates may still be refused, so sampling is bounded as well
+    long long triesLeft = static_cast<long long>(grid.getCellCount()) * SCATTER_TRIES_PER_CELL;
+    while (obstacleCount < maxObstacles && triesLeft-- > 0) {
+        int x = rng.NextInt(grid.getColumns());
+        int y = rng.NextInt(grid.getRows());
+
+        // Avoid placing obstacles at start, exit, or already obstacle cells
+        if ((x == 0 && y == 0) || (x == exitX && y == exitY) || grid.IsObstacle(x, y)) {
+            continue;
+        }
+
+        // Only keep obstacles that leave the maze solvable (sprite variant comes from the cell hash)
+        if (placer.TryPlace(x, y)) {
+            obstacleCount++;
+        }
+    }
+    return obstacleCount;
+}
+
+MazeBuildResult MazeBuilder::Build(MazeGrid& grid, int columns, int rows, const MazeRules& rules,
+                                   GenerationMode mode, uint64_t mazeSeed) {
+    // Same draw order as ResetGame: variant seed, carve, exit, obstacles
+    m_random.BeginMaze(mazeSeed);
+    grid.Reset(columns, rows);
+    grid.setVariantSeed(static_cast<uint32_t>(m_random.Stream(RngStream::Maze)()));
+
+    if (mode == GenerationMode::Parallel) {
+        CarveMazeTiled(grid, rules.algorithm, GENERATION_TILE_SIZE, m_random.Stream(RngStream::Maze));
+    } else {
+        if (!m_generator || m_generator->Algorithm() != rules.algorithm) {
+            m_generator = CreateMazeGenerator(rules.algorithm);
+        }
+        CarveMaze(grid, *m_generator, m_random.Stream(RngStream::Maze));
+    }
+
+    int exitIndex = ChooseExit(grid, m_solver, rules.exitPlacement, m_random.Stream(RngStream::Exit));
+    MazeBuildResult result{exitIndex % columns, exitIndex / columns, 0};
+    result.obstacles = ScatterObstacles(grid, m_solver, result.exitX, result.exitY,
+                                        rules.obstaclePercentage, m_random.Stream(RngStream::Obstacles));
+    return result;
+}
@@ -0,0 +1,61 @@
+#ifndef MAZE_BUILDER_H
+#define MAZE_BUILDER_H
+
+#include <memory>
+#include "maze_generators.h"
+#include "maze_grid.h"
+#include "maze_solver.h"
+#include "maze_types.h"
+#include "rng.h"
+
+// Tile edge length (in cells) for GenerationMode::Parallel
+const int GENERATION_TILE_SIZE = 64;
+// Smallest maze side (in cells) the game and mazegen accept; below it there is no
+// room for both the exit's minimum distance and a meaningful share of obstacles
+const int MIN_MAZE_SIZE = 8;
+// Random obstacle candidates ScatterObstacles draws per maze cell before settling for fewer obstacles
+const int SCATTER_TRIES_PER_CELL = 32;
+
+// The maze-shaping half of a difficulty (cell size and time bonus stay in DifficultySettings)
+struct MazeRules {
+    float obstaclePercentage;
+    MazeAlgorithm algorithm;
+    ExitPlacement exitPlacement;
+
+    static MazeRules Get(Difficulty diff);
+};
+
+// Raylib-free building blocks. Nothing here touches GAME_STATE: maze.cpp wraps
+// them for the game, and MazeBuilder chains them for headless tools.
+
+// Carves the whole (freshly reset) grid with one generator
+void CarveMaze(MazeGrid& grid, MazeGenerator& generator, Xoshiro256& rng);
+// Carves tiles concurrently, then stitches them into one perfect maze
+void CarveMazeTiled(MazeGrid& grid, MazeAlgorithm algorithm, int tileSize, Xoshiro256& rng);
+// Returns the cell index of an exit reachable from (0, 0)
+int ChooseExit(const MazeGrid& grid, MazeSolver& solver, ExitPlacement placement, Xoshiro256& rng);
+// Adds obstacles that keep (0, 0) -> exit solvable; returns how many were placed,
+// which is fewer than percentage asks for when the maze has too few free cells
+int ScatterObstacles(MazeGrid& grid, MazeSolver& solver, int exitX, int exitY, float percentage, Xoshiro256& rng);
+
+struct MazeBuildResult {
+    int exitX;
+    int exitY;
+    int obstacles;
+};
+
+// Builds complete mazes from a maze seed, drawing from the same streams in the
+// same order as ResetGame, so a seed gives the same maze here and in the game.
+// Keeps its generator and solver between builds; use one per thread.
+class MazeBuilder {
+public:
+    MazeBuildResult Build(MazeGrid& grid, int columns, int rows, const MazeRules& rules,
+                          GenerationMode mode, uint64_t mazeSeed);
+
+private:
+    std::unique_ptr<MazeGenerator> m_generator;
+    MazeSolver m_solver;
+    RandomService m_random;
+};
+
+#endif
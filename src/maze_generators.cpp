@@ -0,0 +1,310 @@
+#include "maze_generators.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    // Depth-first search with an explicit stack (the original generator)
+    class BacktrackerGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::Backtracker; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            const int cols = grid.getColumns();
+
+            m_stack.clear();
+            m_stack.reserve(region.CellCount());
+            grid.SetVisited(region.x0, region.y0);
+            m_stack.push_back(grid.Index(region.x0, region.y0));
+
+            while (!m_stack.empty()) {
+                int x = m_stack.back() % cols;
+                int y = m_stack.back() / cols;
+
+                int candidates[4];
+                int count = 0;
+                for (int i = 0; i < 4; i++) {
+                    int nx = x + DIRECTION_DX[i];
+                    int ny = y + DIRECTION_DY[i];
+                    if (nx >= region.x0 && nx < region.x1 && ny >= region.y0 && ny < region.y1 && !grid.IsVisited(nx, ny)) {
+                        candidates[count++] = i;
+                    }
+                }
+
+                if (count > 0) {
+                    int direction = candidates[rng.NextInt(count)];
+                    int nx = x + DIRECTION_DX[direction];
+                    int ny = y + DIRECTION_DY[direction];
+                    grid.SetVisited(nx, ny);
+                    grid.RemoveWall(x, y, direction);
+                    m_stack.push_back(grid.Index(nx, ny));
+                } else {
+                    m_stack.pop_back();
+                }
+            }
+        }
+
+    private:
+        std::vector<int> m_stack;
+    };
+
+    // Shuffled edge list joined through a union-find forest
+    class KruskalGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::Kruskal; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            const int width = region.Width();
+            const int height = region.Height();
+            const int cellCount = region.CellCount();
+
+            // Edge = local cell * 2 + (0: east neighbour, 1: south neighbour)
+            m_edges.clear();
+            m_edges.reserve(cellCount * 2);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    int cell = y * width + x;
+                    if (x + 1 < width) m_edges.push_back(cell * 2);
+                    if (y + 1 < height) m_edges.push_back(cell * 2 + 1);
+                }
+            }
+            std::shuffle(m_edges.begin(), m_edges.end(), rng);
+
+            m_parent.resize(cellCount);
+            m_size.assign(cellCount, 1);
+            std::iota(m_parent.begin(), m_parent.end(), 0);
+
+            int joined = 0;
+            for (int edge : m_edges) {
+                if (joined == cellCount - 1) break;
+
+                int cell = edge >> 1;
+                bool south = edge & 1;
+                int a = Find(cell);
+                int b = Find(south ? cell + width : cell + 1);
+                if (a == b) continue;
+
+                // Union by size
+                if (m_size[a] < m_size[b]) std::swap(a, b);
+                m_parent[b] = a;
+                m_size[a] += m_size[b];
+                joined++;
+
+                grid.RemoveWall(region.x0 + cell % width, region.y0 + cell / width, south ? 2 : 1);
+            }
+        }
+
+    private:
+        int Find(int cell) {
+            while (m_parent[cell] != cell) {
+                m_parent[cell] = m_parent[m_parent[cell]];  // Path halving
+                cell = m_parent[cell];
+            }
+            return cell;
+        }
+
+        std::vector<int> m_edges;
+        std::vector<int> m_parent;
+        std::vector<int> m_size;
+    };
+
+    // Randomized Prim: grow from one cell by attaching random frontier cells
+    class PrimGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::Prim; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            m_width = region.Width();
+            m_height = region.Height();
+            m_state.assign(region.CellCount(), Outside);
+            m_frontier.clear();
+            m_frontier.reserve(region.CellCount());
+
+            int start = rng.NextInt(region.CellCount());
+            m_state[start] = InMaze;
+            AddFrontier(start);
+
+            while (!m_frontier.empty()) {
+                int slot = rng.NextInt(static_cast<int>(m_frontier.size()));
+                int cell = m_frontier[slot];
+                m_frontier[slot] = m_frontier.back();
+                m_frontier.pop_back();
+
+                int x = cell % m_width;
+                int y = cell / m_width;
+
+                // Attach to a random neighbour that is already part of the maze
+                int candidates[4];
+                int count = 0;
+                for (int i = 0; i < 4; i++) {
+                    int nx = x + DIRECTION_DX[i];
+                    int ny = y + DIRECTION_DY[i];
+                    if (nx >= 0 && nx < m_width && ny >= 0 && ny < m_height && m_state[ny * m_width + nx] == InMaze) {
+                        candidates[count++] = i;
+                    }
+                }
+                grid.RemoveWall(region.x0 + x, region.y0 + y, candidates[rng.NextInt(count)]);
+
+                m_state[cell] = InMaze;
+                AddFrontier(cell);
+            }
+        }
+
+    private:
+        enum : uint8_t { Outside, Frontier, InMaze };
+
+        void AddFrontier(int cell) {
+            int x = cell % m_width;
+            int y = cell / m_width;
+            for (int i = 0; i < 4; i++) {
+                int nx = x + DIRECTION_DX[i];
+                int ny = y + DIRECTION_DY[i];
+                if (nx >= 0 && nx < m_width && ny >= 0 && ny < m_height && m_state[ny * m_width + nx] == Outside) {
+                    m_state[ny * m_width + nx] = Frontier;
+                    m_frontier.push_back(ny * m_width + nx);
+                }
+            }
+        }
+
+        int m_width = 0;
+        int m_height = 0;
+        std::vector<uint8_t> m_state;
+        std::vector<int> m_frontier;
+    };
+
+    // Wilson: loop-erased random walks, samples uniformly among all spanning trees
+    class WilsonGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::Wilson; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            const int width = region.Width();
+            const int height = region.Height();
+            const int cellCount = region.CellCount();
+
+            m_inTree.assign(cellCount, 0);
+            m_walk.resize(cellCount);
+            m_inTree[rng.NextInt(cellCount)] = 1;
+
+            for (int start = 0; start < cellCount; start++) {
+                if (m_inTree[start]) continue;
+
+                // Random walk until the tree is hit; overwriting m_walk erases loops
+                int cell = start;
+                while (!m_inTree[cell]) {
+                    int x = cell % width;
+                    int y = cell / width;
+
+                    int candidates[4];
+                    int count = 0;
+                    for (int i = 0; i < 4; i++) {
+                        int nx = x + DIRECTION_DX[i];
+                        int ny = y + DIRECTION_DY[i];
+                        if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                            candidates[count++] = i;
+                        }
+                    }
+
+                    int direction = candidates[rng.NextInt(count)];
+                    m_walk[cell] = static_cast<uint8_t>(direction);
+                    cell = (y + DIRECTION_DY[direction]) * width + x + DIRECTION_DX[direction];
+                }
+
+                // Retrace the loop-erased path and add it to the tree
+                cell = start;
+                while (!m_inTree[cell]) {
+                    int x = cell % width;
+                    int y = cell / width;
+                    int direction = m_walk[cell];
+
+                    grid.RemoveWall(region.x0 + x, region.y0 + y, direction);
+                    m_inTree[cell] = 1;
+                    cell = (y + DIRECTION_DY[direction]) * width + x + DIRECTION_DX[direction];
+                }
+            }
+        }
+
+    private:
+        std::vector<uint8_t> m_inTree;
+        std::vector<uint8_t> m_walk;   // Last direction taken out of each cell
+    };
+
+    // Binary tree: every cell opens either north or west
+    class BinaryTreeGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::BinaryTree; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            for (int y = region.y0; y < region.y1; y++) {
+                for (int x = region.x0; x < region.x1; x++) {
+                    bool canNorth = y > region.y0;
+                    bool canWest = x > region.x0;
+
+                    if (canNorth && canWest) {
+                        grid.RemoveWall(x, y, (rng() & 1) ? 0 : 3);
+                    } else if (canNorth) {
+                        grid.RemoveWall(x, y, 0);
+                    } else if (canWest) {
+                        grid.RemoveWall(x, y, 3);
+                    }
+                }
+            }
+        }
+    };
+
+    // Sidewinder: carve eastward runs, each closed by one opening to the north
+    class SidewinderGenerator : public MazeGenerator {
+    public:
+        MazeAlgorithm Algorithm() const override { return MazeAlgorithm::Sidewinder; }
+
+        void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) override {
+            for (int y = region.y0; y < region.y1; y++) {
+                int runStart = region.x0;
+
+                for (int x = region.x0; x < region.x1; x++) {
+                    bool atEastEdge = x + 1 == region.x1;
+                    bool atNorthEdge = y == region.y0;
+
+                    if (atEastEdge || (!atNorthEdge && (rng() & 1))) {
+                        if (!atNorthEdge) {
+                            grid.RemoveWall(runStart + rng.NextInt(x - runStart + 1), y, 0);
+                        }
+                        runStart = x + 1;
+                    } else {
+                        grid.RemoveWall(x, y, 1);
+                    }
+                }
+            }
+        }
+    };
+}
+
+std::unique_ptr<MazeGenerator> CreateMazeGenerator(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case MazeAlgorithm::Backtracker:
+            return std::make_unique<BacktrackerGenerator>();
+        case MazeAlgorithm::Kruskal:
+            return std::make_unique<KruskalGenerator>();
+        case MazeAlgorithm::Prim:
+            return std::make_unique<PrimGenerator>();
+        case MazeAlgorithm::Wilson:
+            return std::make_unique<WilsonGenerator>();
+        case MazeAlgorithm::BinaryTree:
+            return std::make_unique<BinaryTreeGenerator>();
+        case MazeAlgorithm::Sidewinder:
+            return std::make_unique<SidewinderGenerator>();
+        default:
+            return std::make_unique<BacktrackerGenerator>();
+    }
+}
+
+const char* GetMazeAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case MazeAlgorithm::Backtracker: return "Backtracker";
+        case MazeAlgorithm::Kruskal: return "Kruskal";
+        case MazeAlgorithm::Prim: return "Prim";
+        case MazeAlgorithm::Wilson: return "Wilson";
+        case MazeAlgorithm::BinaryTree: return "Binary Tree";
+        case MazeAlgorithm::Sidewinder: return "Sidewinder";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef MAZE_GENERATORS_H
+#define MAZE_GENERATORS_H
+
+#include <memory>
+#include <vector>
+#include "maze_grid.h"
+#include "maze_types.h"
+#include "rng.h"
+
+// Half-open rectangle of cells [x0, x1) x [y0, y1)
+struct MazeRegion {
+    int x0, y0, x1, y1;
+
+    int Width() const { return x1 - x0; }
+    int Height() const { return y1 - y0; }
+    int CellCount() const { return Width() * Height(); }
+};
+
+// Carves a perfect maze inside a region of a grid whose walls are all closed.
+// Generators only open walls between cells of the region, so disjoint regions
+// can be carved concurrently. Scratch buffers are kept between calls; the
+// carve loops themselves never allocate.
+class MazeGenerator {
+public:
+    virtual ~MazeGenerator() = default;
+    virtual MazeAlgorithm Algorithm() const = 0;
+    virtual void Generate(MazeGrid& grid, const MazeRegion& region, Xoshiro256& rng) = 0;
+};
+
+std::unique_ptr<MazeGenerator> CreateMazeGenerator(MazeAlgorithm algorithm);
+const char* GetMazeAlgorithmName(MazeAlgorithm algorithm);
+
+#endif
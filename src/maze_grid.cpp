@@ -0,0 +1,50 @@
+#include "maze_grid.h"
+#include <algorithm>
+
+void MazeGrid::Reset(int columns, int rows) {
+    m_cols = columns;
+    m_rows = rows;
+    m_cells.assign(static_cast<size_t>(columns) * rows, WALL_ALL);
+    m_obstacles.assign((static_cast<size_t>(columns) * rows + 63) / 64, 0);
+    m_rowOrigin = 0;
+}
+
+void MazeGrid::ShiftRowsUp(int count) {
+    count = std::min(count, m_rows);
+    const int shifted = count * m_cols;
+    const int cellCount = getCellCount();
+
+    std::copy(m_cells.begin() + shifted, m_cells.end(), m_cells.begin());
+    std::fill(m_cells.end() - shifted, m_cells.end(), WALL_ALL);
+
+    for (int i = 0; i < cellCount; i++) {
+        bool obstacle = i + shifted < cellCount && ((m_obstacles[(i + shifted) >> 6] >> ((i + shifted) & 63)) & 1);
+        if (obstacle) m_obstacles[i >> 6] |= uint64_t(1) << (i & 63);
+        else m_obstacles[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    m_rowOrigin += count;
+}
+
+void MazeGrid::RemoveWall(int x, int y, int direction) {
+    m_cells[Index(x, y)] &= ~(1 << direction);
+
+    // Clear the opposite wall of the neighbour
+    int nx = x + DIRECTION_DX[direction];
+    int ny = y + DIRECTION_DY[direction];
+    if (InBounds(nx, ny)) {
+        m_cells[Index(nx, ny)] &= ~(1 << ((direction + 2) & 3));
+    }
+}
+
+uint32_t MazeGrid::CellHash(int x, int y) const {
+    // lowbias32 integer hash of the packed coordinates
+    uint32_t row = static_cast<uint32_t>(y + m_rowOrigin);
+    uint32_t h = m_variantSeed ^ (static_cast<uint32_t>(x) * 0x9E3779B1u) ^ (row * 0x85EBCA77u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
@@ -0,0 +1,80 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Wall bits, indexed the same way as the `directions` table in maze.h
+const uint8_t WALL_TOP = 1 << 0;
+const uint8_t WALL_RIGHT = 1 << 1;
+const uint8_t WALL_BOTTOM = 1 << 2;
+const uint8_t WALL_LEFT = 1 << 3;
+const uint8_t WALL_ALL = WALL_TOP | WALL_RIGHT | WALL_BOTTOM | WALL_LEFT;
+
+// Neighbour offsets in Top/Right/Bottom/Left order
+const int DIRECTION_DX[4] = {0, 1, 0, -1};
+const int DIRECTION_DY[4] = {-1, 0, 1, 0};
+
+// Scratch flag used by the generators, stored next to the wall nibble
+const uint8_t CELL_VISITED = 1 << 4;
+
+// Contiguous, row-major maze storage.
+// Each cell is one byte (4 wall bits + generator flags), obstacles live in a
+// separate bitmap and sprite variants are derived from a per-cell hash.
+class MazeGrid {
+public:
+    MazeGrid() = default;
+
+    // Resize the grid and close every wall; clears obstacles and visited flags
+    void Reset(int columns, int rows);
+
+    // Drop the top `count` rows and append fresh closed rows at the bottom.
+    // Sprite variants follow the rows, since they hash the absolute row.
+    void ShiftRowsUp(int count);
+    long long getRowOrigin() const { return m_rowOrigin; }
+
+    int getColumns() const { return m_cols; }
+    int getRows() const { return m_rows; }
+    int getCellCount() const { return m_cols * m_rows; }
+    bool Empty() const { return m_cells.empty(); }
+
+    int Index(int x, int y) const { return y * m_cols + x; }
+    bool InBounds(int x, int y) const { return x >= 0 && x < m_cols && y >= 0 && y < m_rows; }
+
+    // Walls
+    uint8_t Walls(int x, int y) const { return m_cells[Index(x, y)] & WALL_ALL; }
+    bool HasWall(int x, int y, int direction) const { return (m_cells[Index(x, y)] >> direction) & 1; }
+    void RemoveWall(int x, int y, int direction);   // Opens the passage on both sides
+
+    // Generator scratch flag
+    bool IsVisited(int x, int y) const { return (m_cells[Index(x, y)] & CELL_VISITED) != 0; }
+    void SetVisited(int x, int y) { m_cells[Index(x, y)] |= CELL_VISITED; }
+
+    // Obstacles
+    bool IsObstacle(int x, int y) const {
+        int i = Index(x, y);
+        return (m_obstacles[i >> 6] >> (i & 63)) & 1;
+    }
+    void SetObstacle(int x, int y, bool obstacle) {
+        int i = Index(x, y);
+        if (obstacle) m_obstacles[i >> 6] |= uint64_t(1) << (i & 63);
+        else m_obstacles[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    // Sprite variants are a stable function of (seed, x, y), so nothing is stored per cell
+    void setVariantSeed(uint32_t seed) { m_variantSeed = seed; }
+    uint32_t getVariantSeed() const { return m_variantSeed; }
+    uint32_t CellHash(int x, int y) const;
+    int SpriteVariant(int x, int y, int variantCount) const { return static_cast<int>(CellHash(x, y) % variantCount); }
+
+private:
+    int m_cols = 0;
+    int m_rows = 0;
+    uint32_t m_variantSeed = 0;
+    long long m_rowOrigin = 0;          // Absolute row of local row 0
+    std::vector<uint8_t> m_cells;       // Wall mask + flags, row stride == m_cols
+    std::vector<uint64_t> m_obstacles;  // One bit per cell
+};
+
+#endif
@@ -0,0 +1,174 @@
+#include "maze_layer.h"
+#include <algorithm>
+#include "game_state.h"
+#include "maze.h"
+#include "rlgl.h"
+
+void MazeLayer::Invalidate() {
+    m_segmentsValid = false;
+    for (int index : m_resident) m_chunks[index].valid = false;
+}
+
+void MazeLayer::RebuildSegments() {
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    int perCell = BuildWallSegments(grid, m_segments);
+    m_wallStats[GAME_STATE.getCurrentDifficulty()] = {perCell, static_cast<int>(m_segments.size())};
+
+    int chunkColumns = (grid.getColumns() + MAZE_CHUNK_CELLS - 1) / MAZE_CHUNK_CELLS;
+    int chunkRows = (grid.getRows() + MAZE_CHUNK_CELLS - 1) / MAZE_CHUNK_CELLS;
+    if (chunkColumns != m_chunkColumns || chunkRows != m_chunkRows) {
+        for (int index : m_resident) UnloadRenderTexture(m_chunks[index].texture);
+        m_resident.clear();
+        m_chunkColumns = chunkColumns;
+        m_chunkRows = chunkRows;
+        m_chunks.assign(chunkColumns * chunkRows, Chunk{});
+        m_chunkSegments.resize(m_chunks.size());
+    }
+    for (auto& list : m_chunkSegments) list.clear();
+
+    // A segment goes to every chunk whose cell range, edges included, it touches;
+    // each chunk texture clips it to its own pixels
+    for (int i = 0; i < static_cast<int>(m_segments.size()); i++) {
+        const WallSegment& segment = m_segments[i];
+        int chunkX0 = std::max(0, (segment.x0 - 1) / MAZE_CHUNK_CELLS);
+        int chunkY0 = std::max(0, (segment.y0 - 1) / MAZE_CHUNK_CELLS);
+        int chunkX1 = std::min(m_chunkColumns - 1, segment.x1 / MAZE_CHUNK_CELLS);
+        int chunkY1 = std::min(m_chunkRows - 1, segment.y1 / MAZE_CHUNK_CELLS);
+        for (int chunkY = chunkY0; chunkY <= chunkY1; chunkY++) {
+            for (int chunkX = chunkX0; chunkX <= chunkX1; chunkX++) {
+                m_chunkSegments[chunkY * m_chunkColumns + chunkX].push_back(i);
+            }
+        }
+    }
+
+    m_segmentsValid = true;
+}
+
+void MazeLayer::RenderChunk(int chunkX, int chunkY, Chunk& chunk) {
+    const int cellSize = GAME_STATE.getCellSize();
+    const int pixels = MAZE_CHUNK_CELLS * cellSize;
+    const float margin = static_cast<float>(GAME_STATE.getMargin());
+
+    bool resident = IsRenderTextureValid(chunk.texture);
+    if (!resident || chunk.texture.texture.width != pixels) {
+        if (resident) UnloadRenderTexture(chunk.texture);
+        else m_resident.push_back(chunkY * m_chunkColumns + chunkX);
+        chunk.texture = LoadRenderTexture(pixels, pixels);
+    }
+
+    BeginTextureMode(chunk.texture);
+    ClearBackground(BLANK);
+
+    // Premultiply colour but accumulate alpha as usual, so translucent walls and
+    // sprites look the same after Draw blends them a second time
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+    // Draw in world coordinates shifted so the chunk's corner lands on the texture origin
+    rlPushMatrix();
+    rlTranslatef(-(margin + chunkX * pixels), -(margin + chunkY * pixels), 0.0f);
+
+    m_scratch.clear();
+    for (int index : m_chunkSegments[chunkY * m_chunkColumns + chunkX]) m_scratch.push_back(m_segments[index]);
+    m_wallMesh.Build(m_scratch, Vector2{margin, margin}, static_cast<float>(cellSize));
+    m_wallMesh.Draw(GAME_STATE.getCurrentColors().wallColor);
+
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const int x1 = std::min((chunkX + 1) * MAZE_CHUNK_CELLS, grid.getColumns());
+    const int y1 = std::min((chunkY + 1) * MAZE_CHUNK_CELLS, grid.getRows());
+    for (int y = chunkY * MAZE_CHUNK_CELLS; y < y1; y++) {
+        for (int x = chunkX * MAZE_CHUNK_CELLS; x < x1; x++) {
+            if (grid.IsObstacle(x, y)) Cell(x, y).Draw();
+        }
+    }
+    GameResources::spriteBatch.Flush();
+
+    rlPopMatrix();
+    EndBlendMode();
+    EndTextureMode();
+
+    chunk.valid = true;
+}
+
+void MazeLayer::Update(const CellRect& visible) {
+    if (!m_segmentsValid) RebuildSegments();
+    if (visible.IsEmpty()) return;
+
+    const int chunkX0 = visible.x0 / MAZE_CHUNK_CELLS;
+    const int chunkY0 = visible.y0 / MAZE_CHUNK_CELLS;
+    const int chunkX1 = visible.x1 / MAZE_CHUNK_CELLS;
+    const int chunkY1 = visible.y1 / MAZE_CHUNK_CELLS;
+    for (int chunkY = chunkY0; chunkY <= chunkY1; chunkY++) {
+        for (int chunkX = chunkX0; chunkX <= chunkX1; chunkX++) {
+            Chunk& chunk = At(chunkX, chunkY);
+            if (!chunk.valid) RenderChunk(chunkX, chunkY, chunk);
+        }
+    }
+
+    // Keep one ring of chunks around the view so small camera moves do not re-render
+    m_resident.erase(std::remove_if(m_resident.begin(), m_resident.end(), [&](int index) {
+        int chunkX = index % m_chunkColumns;
+        int chunkY = index / m_chunkColumns;
+        if (chunkX >= chunkX0 - 1 && chunkX <= chunkX1 + 1 && chunkY >= chunkY0 - 1 && chunkY <= chunkY1 + 1) return false;
+        UnloadRenderTexture(m_chunks[index].texture);
+        m_chunks[index] = Chunk{};
+        return true;
+    }), m_resident.end());
+}
+
+void MazeLayer::Draw(const CellRect& visible) const {
+    m_drawnCount = 0;
+    if (visible.IsEmpty() || !m_segmentsValid) return;
+
+    const float margin = static_cast<float>(GAME_STATE.getMargin());
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    for (int chunkY = visible.y0 / MAZE_CHUNK_CELLS; chunkY <= visible.y1 / MAZE_CHUNK_CELLS; chunkY++) {
+        for (int chunkX = visible.x0 / MAZE_CHUNK_CELLS; chunkX <= visible.x1 / MAZE_CHUNK_CELLS; chunkX++) {
+            const Chunk& chunk = At(chunkX, chunkY);
+            if (!chunk.valid) continue;
+
+            const Texture2D& texture = chunk.texture.texture;
+            // Render textures are stored bottom-up, hence the negative source height
+            DrawTextureRec(texture, Rectangle{0, 0, static_cast<float>(texture.width), -static_cast<float>(texture.height)},
+                           Vector2{margin + chunkX * texture.width, margin + chunkY * texture.height}, WHITE);
+            m_drawnCount++;
+        }
+    }
+    EndBlendMode();
+}
+
+void MazeLayer::Unload() {
+    for (int index : m_resident) UnloadRenderTexture(m_chunks[index].texture);
+    m_resident.clear();
+    m_chunks.clear();
+    m_chunkSegments.clear();
+    m_chunkColumns = m_chunkRows = 0;
+    m_segmentsValid = false;
+    m_wallMesh.Unload();
+}
+
+// F3 overlay: wall draw calls per cell versus merged segments, per difficulty
+// played so far, and how many chunks the current view keeps on the GPU
+void MazeLayer::DrawDebugOverlay() const {
+    static const char* DIFFICULTY_NAMES[3] = {"Easy", "Medium", "Hard"};
+    const int x = 10;
+    int y = GAME_STATE.getScreenHeight() - 110;
+
+    DrawRectangle(x - 5, y - 5, 420, 105, Fade(BLACK, 0.6f));
+    DrawText("Wall segments (per-cell -> merged)", x, y, 18, LIGHTGRAY);
+    for (int i = 0; i < 3; i++) {
+        y += 20;
+        const WallStats& stats = m_wallStats[i];
+        if (stats.merged == 0) {
+            DrawText(TextFormat("%-6s  -", DIFFICULTY_NAMES[i]), x, y, 18, GRAY);
+        } else {
+            DrawText(TextFormat("%-6s  %5d -> %4d  (%.1fx)", DIFFICULTY_NAMES[i], stats.perCell, stats.merged,
+                                static_cast<float>(stats.perCell) / stats.merged),
+                     x, y, 18, i == GAME_STATE.getCurrentDifficulty() ? YELLOW : WHITE);
+        }
+    }
+    y += 20;
+    DrawText(TextFormat("Chunks  %d drawn, %d resident of %d", m_drawnCount, static_cast<int>(m_resident.size()),
+                        m_chunkColumns * m_chunkRows),
+             x, y, 18, LIGHTGRAY);
+}
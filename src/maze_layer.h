@@ -0,0 +1,66 @@
+#ifndef MAZE_LAYER_H
+#define MAZE_LAYER_H
+
+#include <vector>
+#include "raylib.h"
+#include "camera_view.h"
+#include "wall_mesh.h"
+#include "wall_segments.h"
+
+// Cells per side of one cached chunk of the maze layer
+const int MAZE_CHUNK_CELLS = 16;
+
+// Walls and obstacles only change with the maze or theme, so they are rendered
+// into off-screen textures, one per chunk of cells, and drawn as one quad per
+// chunk. Only chunks intersecting the view are rendered, drawn and kept
+// resident, so the per-frame cost follows the viewport rather than the maze.
+class MazeLayer {
+public:
+    // Drop every cached chunk (maze, theme or cell size changed)
+    void Invalidate();
+
+    // Render visible chunks that are missing or stale and evict far-away ones.
+    // Uses off-screen passes, so call it outside BeginMode2D.
+    void Update(const CellRect& visible);
+
+    // Draw the visible chunks in world space, inside BeginMode2D
+    void Draw(const CellRect& visible) const;
+
+    void Unload();
+
+    // F3 overlay: merged wall segments per difficulty and chunk residency
+    void DrawDebugOverlay() const;
+
+private:
+    struct Chunk {
+        RenderTexture2D texture = {0};
+        bool valid = false;
+    };
+
+    struct WallStats {
+        int perCell;
+        int merged;
+    };
+
+    void RebuildSegments();
+    void RenderChunk(int chunkX, int chunkY, Chunk& chunk);
+    Chunk& At(int chunkX, int chunkY) { return m_chunks[chunkY * m_chunkColumns + chunkX]; }
+    const Chunk& At(int chunkX, int chunkY) const { return m_chunks[chunkY * m_chunkColumns + chunkX]; }
+
+    std::vector<Chunk> m_chunks;
+    std::vector<int> m_resident;    // Chunks holding a render texture
+    int m_chunkColumns = 0;
+    int m_chunkRows = 0;
+    bool m_segmentsValid = false;
+
+    // Merged wall runs of the whole maze, and the ones touching each chunk
+    std::vector<WallSegment> m_segments;
+    std::vector<std::vector<int>> m_chunkSegments;
+    std::vector<WallSegment> m_scratch;
+    WallMesh m_wallMesh;
+
+    WallStats m_wallStats[3] = {};
+    mutable int m_drawnCount = 0;
+};
+
+#endif
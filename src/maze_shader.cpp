@@ -0,0 +1,256 @@
+#include "maze_shader.h"
+#include <algorithm>
+#include "game_state.h"
+#include "rlgl.h"
+#include "wall_mesh.h"
+
+namespace {
+    const char* MAZE_VERTEX_SHADER = R"(#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+out vec2 worldPosition;
+
+void main() {
+    worldPosition = vertexPosition.xy;
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+    const char* MAZE_FRAGMENT_SHADER = R"(#version 330
+in vec2 worldPosition;
+out vec4 finalColor;
+
+uniform sampler2D cells;        // One texel per cell, rows stored as a ring
+uniform sampler2D atlas;
+uniform vec2 mazeOrigin;        // World position of grid corner (0, 0)
+uniform float cellSize;
+uniform ivec2 gridSize;
+uniform int rowOffset;          // Ring row holding grid row 0
+uniform float wallThickness;
+uniform vec4 wallColor;
+uniform vec4 obstacleTint;
+uniform vec4 altTint;
+uniform vec4 obstacleRect;      // Atlas UV rectangle of the obstacle sprite(sheet)
+uniform ivec2 obstacleFrames;   // Spritesheet columns and rows
+uniform vec4 altRect;           // Atlas UV rectangle of the second obstacle (desert)
+uniform int useAlt;
+
+ivec2 Cell(ivec2 c) {
+    if (c.x >= gridSize.x || c.y >= gridSize.y) return ivec2(0);
+    vec4 texel = texelFetch(cells, ivec2(c.x, (c.y + rowOffset) % gridSize.y), 0);
+    return ivec2(round(texel.rg * 255.0));
+}
+
+void main() {
+    vec2 local = (worldPosition - mazeOrigin) / cellSize;
+    ivec2 c = ivec2(floor(local));
+    if (any(lessThan(c, ivec2(0))) || any(greaterThanEqual(c, gridSize))) discard;
+
+    vec2 inCell = (local - vec2(c)) * cellSize;
+    ivec2 cell = Cell(c);
+
+    // Like the wall mesh, a wall covers the last pixels before its grid line,
+    // so each cell draws its own right and bottom walls
+    bool right = inCell.x >= cellSize - wallThickness;
+    bool bottom = inCell.y >= cellSize - wallThickness;
+    bool wall = (bottom && (cell.x & 4) != 0) || (right && (cell.x & 2) != 0);
+    if (right && bottom && !wall) {
+        // Corner pixel: walls of the neighbours that end on this corner
+        wall = (Cell(c + ivec2(1, 0)).x & 4) != 0 || (Cell(c + ivec2(0, 1)).x & 2) != 0;
+    }
+
+    vec4 color = wall ? vec4(wallColor.rgb * wallColor.a, wallColor.a) : vec4(0.0);
+
+    // Obstacle sprite over 80% of the cell, composited over the walls
+    if ((cell.x & 16) != 0) {
+        vec2 uv = (inCell / cellSize - 0.1) / 0.8;
+        if (all(greaterThanEqual(uv, vec2(0.0))) && all(lessThan(uv, vec2(1.0)))) {
+            vec4 rect = obstacleRect;
+            vec4 tint = obstacleTint;
+            if (useAlt != 0 && cell.y == 1) {
+                rect = altRect;
+                tint = altTint;
+            } else {
+                vec2 frameSize = obstacleRect.zw / vec2(obstacleFrames);
+                ivec2 frame = ivec2(cell.y % obstacleFrames.x, cell.y / obstacleFrames.x);
+                rect = vec4(obstacleRect.xy + vec2(frame) * frameSize, frameSize);
+            }
+            vec4 sprite = texture(atlas, rect.xy + uv * rect.zw) * tint;
+            color = vec4(sprite.rgb * sprite.a, sprite.a) + color * (1.0 - sprite.a);
+        }
+    }
+
+    if (color.a <= 0.0) discard;
+    finalColor = color;     // Premultiplied
+}
+)";
+
+    void SetColor(Shader shader, int location, Color color) {
+        float value[4] = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+        SetShaderValue(shader, location, value, SHADER_UNIFORM_VEC4);
+    }
+
+    void SetAtlasRect(Shader shader, int location, const Texture2D& atlas, Rectangle rect) {
+        float value[4] = { rect.x / atlas.width, rect.y / atlas.height, rect.width / atlas.width, rect.height / atlas.height };
+        SetShaderValue(shader, location, value, SHADER_UNIFORM_VEC4);
+    }
+}
+
+bool MazeShaderLayer::Load() {
+    m_shader = LoadShaderFromMemory(MAZE_VERTEX_SHADER, MAZE_FRAGMENT_SHADER);
+    // raylib falls back to its default shader when compilation fails
+    m_ready = m_shader.id > 0 && m_shader.id != rlGetShaderIdDefault();
+    if (!m_ready) {
+        TraceLog(LOG_WARNING, "MAZE: Shader render path unavailable, using cached chunks");
+        return false;
+    }
+
+    m_locs.cells = GetShaderLocation(m_shader, "cells");
+    m_locs.atlas = GetShaderLocation(m_shader, "atlas");
+    m_locs.mazeOrigin = GetShaderLocation(m_shader, "mazeOrigin");
+    m_locs.cellSize = GetShaderLocation(m_shader, "cellSize");
+    m_locs.gridSize = GetShaderLocation(m_shader, "gridSize");
+    m_locs.rowOffset = GetShaderLocation(m_shader, "rowOffset");
+    m_locs.wallThickness = GetShaderLocation(m_shader, "wallThickness");
+    m_locs.wallColor = GetShaderLocation(m_shader, "wallColor");
+    m_locs.obstacleTint = GetShaderLocation(m_shader, "obstacleTint");
+    m_locs.altTint = GetShaderLocation(m_shader, "altTint");
+    m_locs.obstacleRect = GetShaderLocation(m_shader, "obstacleRect");
+    m_locs.obstacleFrames = GetShaderLocation(m_shader, "obstacleFrames");
+    m_locs.altRect = GetShaderLocation(m_shader, "altRect");
+    m_locs.useAlt = GetShaderLocation(m_shader, "useAlt");
+    m_dirty = true;
+    return true;
+}
+
+int MazeShaderLayer::ObstacleVariants() const {
+    switch (m_theme) {
+        case GameTheme::Space: return ASTEROID_SPRITE_COLUMNS * ASTEROID_SPRITE_ROWS;
+        case GameTheme::Jungle: return LOG_SPRITE_COLUMNS * LOG_SPRITE_ROWS;
+        case GameTheme::Desert: return 2;   // Cactus or tumbleweed, as Cell::GetDesertObstacleType
+        default: return 1;
+    }
+}
+
+void MazeShaderLayer::EncodeRow(int y, unsigned char* texels) const {
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const int variants = ObstacleVariants();
+    for (int x = 0; x < grid.getColumns(); x++) {
+        bool obstacle = grid.IsObstacle(x, y);
+        texels[x * 4 + 0] = static_cast<unsigned char>(grid.Walls(x, y) | (obstacle ? CELL_TEXEL_OBSTACLE : 0));
+        texels[x * 4 + 1] = static_cast<unsigned char>(obstacle ? grid.SpriteVariant(x, y, variants) : 0);
+        texels[x * 4 + 2] = 0;
+        texels[x * 4 + 3] = 255;
+    }
+}
+
+void MazeShaderLayer::UploadAll() {
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const int cols = grid.getColumns();
+    const int rows = grid.getRows();
+
+    if (!IsTextureValid(m_cells) || m_cells.width != cols || m_cells.height != rows) {
+        if (IsTextureValid(m_cells)) UnloadTexture(m_cells);
+        Image image = GenImageColor(cols, rows, BLANK);
+        m_cells = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+
+    // Ring order: grid row y lives in texture row (rowOrigin + y) mod rows
+    m_texels.resize(static_cast<size_t>(cols) * rows * 4);
+    const int offset = static_cast<int>(grid.getRowOrigin() % rows);
+    for (int y = 0; y < rows; y++) {
+        EncodeRow(y, &m_texels[static_cast<size_t>((y + offset) % rows) * cols * 4]);
+    }
+    UpdateTexture(m_cells, m_texels.data());
+    m_lastUploadCells = cols * rows;
+}
+
+void MazeShaderLayer::UploadRows(int firstRow, int count) {
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const int cols = grid.getColumns();
+    const int rows = grid.getRows();
+    const int offset = static_cast<int>(grid.getRowOrigin() % rows);
+
+    m_texels.resize(static_cast<size_t>(cols) * 4);
+    for (int y = firstRow; y < firstRow + count; y++) {
+        EncodeRow(y, m_texels.data());
+        UpdateTextureRec(m_cells, Rectangle{0, static_cast<float>((y + offset) % rows), static_cast<float>(cols), 1},
+                         m_texels.data());
+    }
+    m_lastUploadCells = cols * count;
+}
+
+void MazeShaderLayer::Update() {
+    if (!m_ready || !m_dirty) return;
+
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const long long scrolled = grid.getRowOrigin() - m_rowOrigin;
+    const bool sameTexture = IsTextureValid(m_cells) && m_cells.width == grid.getColumns() && m_cells.height == grid.getRows();
+
+    if (sameTexture && GAME_STATE.getCurrentTheme() == m_theme && scrolled > 0 && scrolled < grid.getRows()) {
+        // Endless scroll: the new rows plus the row above them, whose bottom walls opened
+        const int count = static_cast<int>(std::min<long long>(scrolled + 1, grid.getRows()));
+        UploadRows(grid.getRows() - count, count);
+    } else {
+        m_theme = GAME_STATE.getCurrentTheme();
+        UploadAll();
+    }
+
+    m_rowOrigin = grid.getRowOrigin();
+    m_dirty = false;
+}
+
+void MazeShaderLayer::Draw(const CellRect& visible) {
+    if (!m_ready || visible.IsEmpty() || !IsTextureValid(m_cells)) return;
+
+    const MazeGrid& grid = GAME_STATE.getGrid();
+    const SpriteAtlas& atlas = GameResources::GetThemeAtlas();
+    const Texture2D& atlasTexture = atlas.getTexture();
+    const float cellSize = static_cast<float>(GAME_STATE.getCellSize());
+    const float margin = static_cast<float>(GAME_STATE.getMargin());
+    const ThemeColors& colors = GAME_STATE.getCurrentColors();
+
+    float mazeOrigin[2] = { margin, margin };
+    int gridSize[2] = { grid.getColumns(), grid.getRows() };
+    int rowOffset = static_cast<int>(grid.getRowOrigin() % grid.getRows());
+    float thickness = WALL_THICKNESS;
+    int frames[2] = { atlas.getFrameColumns(SpriteId::Obstacle),
+                      std::max(atlas.getFrameCount(SpriteId::Obstacle) / atlas.getFrameColumns(SpriteId::Obstacle), 1) };
+    int useAlt = atlas.getFrameCount(SpriteId::ObstacleAlt) > 0 ? 1 : 0;
+
+    SetShaderValue(m_shader, m_locs.mazeOrigin, mazeOrigin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(m_shader, m_locs.cellSize, &cellSize, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(m_shader, m_locs.gridSize, gridSize, SHADER_UNIFORM_IVEC2);
+    SetShaderValue(m_shader, m_locs.rowOffset, &rowOffset, SHADER_UNIFORM_INT);
+    SetShaderValue(m_shader, m_locs.wallThickness, &thickness, SHADER_UNIFORM_FLOAT);
+    SetColor(m_shader, m_locs.wallColor, colors.wallColor);
+    SetColor(m_shader, m_locs.obstacleTint, colors.obstacleColor);
+    SetColor(m_shader, m_locs.altTint, Color{55, 41, 14, 255});  // Tumbleweed, as Cell::Draw
+    SetAtlasRect(m_shader, m_locs.obstacleRect, atlasTexture, atlas.getBounds(SpriteId::Obstacle));
+    SetShaderValue(m_shader, m_locs.obstacleFrames, frames, SHADER_UNIFORM_IVEC2);
+    SetAtlasRect(m_shader, m_locs.altRect, atlasTexture, atlas.getBounds(SpriteId::ObstacleAlt));
+    SetShaderValue(m_shader, m_locs.useAlt, &useAlt, SHADER_UNIFORM_INT);
+
+    // One quad over the visible cells; the shader works out everything per pixel
+    BeginShaderMode(m_shader);
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    // Samplers after the mode switches: each of them flushes the batch and its texture slots
+    SetShaderValueTexture(m_shader, m_locs.cells, m_cells);
+    SetShaderValueTexture(m_shader, m_locs.atlas, atlasTexture);
+    DrawRectangleRec(Rectangle{ margin + visible.x0 * cellSize, margin + visible.y0 * cellSize,
+                                (visible.x1 - visible.x0 + 1) * cellSize, (visible.y1 - visible.y0 + 1) * cellSize },
+                     WHITE);
+    EndBlendMode();
+    EndShaderMode();
+}
+
+void MazeShaderLayer::Unload() {
+    if (IsTextureValid(m_cells)) UnloadTexture(m_cells);
+    if (m_ready) UnloadShader(m_shader);
+    m_cells = Texture2D{0};
+    m_shader = Shader{0};
+    m_ready = false;
+    m_dirty = true;
+    m_rowOrigin = 0;
+}
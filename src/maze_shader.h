@@ -0,0 +1,57 @@
+#ifndef MAZE_SHADER_H
+#define MAZE_SHADER_H
+
+#include <vector>
+#include "raylib.h"
+#include "camera_view.h"
+#include "resources.h"
+
+// Cell texel layout: red = wall nibble (top=1, right=2, bottom=4, left=8) plus
+// the obstacle flag, green = the obstacle's sprite variant for the current theme
+const int CELL_TEXEL_OBSTACLE = 16;
+
+// Alternative to MazeLayer: the grid lives on the GPU as one RGBA8 texel per
+// cell and a single fragment shader pass draws walls, obstacle sprites from the
+// theme atlas and theme tints. Cost per frame is one quad over the visible
+// cells. Only rows that changed are re-uploaded: the texture is a ring of rows
+// addressed by absolute row, so an endless-mode scroll uploads just the new rows.
+// Needs GLSL 330 (raylib's OpenGL 3.3 backend; Mesa llvmpipe is enough).
+class MazeShaderLayer {
+public:
+    // Compiles the shader; returns false (and the layer stays unused) when unsupported
+    bool Load();
+    bool IsReady() const { return m_ready; }
+
+    // The maze, theme or atlas changed; the next Update() re-syncs the cell texture
+    void Invalidate() { m_dirty = true; }
+    void Update();
+    void Draw(const CellRect& visible);
+    void Unload();
+
+    // Cells written by the last sync, for the F3 overlay
+    int getLastUploadCells() const { return m_lastUploadCells; }
+
+private:
+    void UploadAll();
+    void UploadRows(int firstRow, int count);
+    void EncodeRow(int y, unsigned char* texels) const;
+    int ObstacleVariants() const;
+
+    Shader m_shader = {0};
+    Texture2D m_cells = {0};
+    std::vector<unsigned char> m_texels;
+    long long m_rowOrigin = 0;          // Grid row origin of the last sync
+    GameTheme m_theme = GameTheme::Space;
+    bool m_ready = false;
+    bool m_dirty = true;
+    int m_lastUploadCells = 0;
+
+    struct {
+        int cells, atlas;
+        int mazeOrigin, cellSize, gridSize, rowOffset, wallThickness;
+        int wallColor, obstacleTint, altTint;
+        int obstacleRect, obstacleFrames, altRect, useAlt;
+    } m_locs = {};
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "maze_solver.h"
+#include <algorithm>
+#include <cstdlib>
+
+void MazeSolver::BeginSearch(int cellCount) {
+    if (static_cast<int>(m_stamp.size()) < cellCount) {
+        m_stamp.resize(cellCount, 0);
+        m_closed.resize(cellCount, 0);
+        m_cost.resize(cellCount);
+        m_parent.resize(cellCount);
+        m_bucket.reserve(cellCount);
+        m_nextBucket.reserve(cellCount);
+    }
+
+    // Stamps only need clearing once every 2^32 searches
+    if (++m_generation == 0) {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        std::fill(m_closed.begin(), m_closed.end(), 0);
+        m_generation = 1;
+    }
+}
+
+int MazeSolver::Search(const MazeGrid& grid, int start, int end) {
+    const int cols = grid.getColumns();
+    const int endX = end % cols;
+    const int endY = end / cols;
+
+    BeginSearch(grid.getCellCount());
+    m_bucket.clear();
+    m_nextBucket.clear();
+
+    m_stamp[start] = m_generation;
+    m_cost[start] = 0;
+    m_parent[start] = start;
+    m_bucket.push_back(start);
+
+    while (!m_bucket.empty() || !m_nextBucket.empty()) {
+        if (m_bucket.empty()) m_bucket.swap(m_nextBucket);
+
+        int index = m_bucket.back();
+        m_bucket.pop_back();
+
+        if (index == end) return m_cost[index];
+        if (m_closed[index] == m_generation) continue;
+        m_closed[index] = m_generation;
+
+        int x = index % cols;
+        int y = index / cols;
+        uint8_t walls = grid.Walls(x, y);
+        int newCost = m_cost[index] + 1;
+
+        for (int direction = 0; direction < 4; direction++) {
+            if (walls & (1 << direction)) continue;
+
+            int nx = x + DIRECTION_DX[direction];
+            int ny = y + DIRECTION_DY[direction];
+            if (!grid.InBounds(nx, ny) || grid.IsObstacle(nx, ny)) continue;
+
+            int next = grid.Index(nx, ny);
+            if (m_stamp[next] == m_generation && m_cost[next] <= newCost) continue;
+
+            m_stamp[next] = m_generation;
+            m_cost[next] = newCost;
+            m_parent[next] = index;
+
+            // Moving toward the goal keeps f, moving away raises it by 2
+            int oldH = std::abs(x - endX) + std::abs(y - endY);
+            int newH = std::abs(nx - endX) + std::abs(ny - endY);
+            if (newH < oldH) m_bucket.push_back(next);
+            else m_nextBucket.push_back(next);
+        }
+    }
+    return -1;
+}
+
+bool MazeSolver::PathExists(const MazeGrid& grid, int startX, int startY, int endX, int endY) {
+    return Search(grid, grid.Index(startX, startY), grid.Index(endX, endY)) >= 0;
+}
+
+int MazeSolver::ShortestPathLength(const MazeGrid& grid, int startX, int startY, int endX, int endY) {
+    return Search(grid, grid.Index(startX, startY), grid.Index(endX, endY));
+}
+
+bool MazeSolver::FindPath(const MazeGrid& grid, int startX, int startY, int endX, int endY, std::vector<int>& path) {
+    path.clear();
+    int start = grid.Index(startX, startY);
+    int end = grid.Index(endX, endY);
+    if (Search(grid, start, end) < 0) return false;
+
+    for (int index = end; ; index = m_parent[index]) {
+        path.push_back(index);
+        if (index == start) break;
+    }
+    return true;
+}
+
+void MazeSolver::FloodFill(const MazeGrid& grid, int startX, int startY) {
+    const int cols = grid.getColumns();
+
+    BeginSearch(grid.getCellCount());
+    m_bucket.clear();
+
+    // Plain BFS; m_bucket doubles as the FIFO queue
+    int start = grid.Index(startX, startY);
+    m_stamp[start] = m_generation;
+    m_cost[start] = 0;
+    m_parent[start] = start;
+    m_bucket.push_back(start);
+
+    for (size_t head = 0; head < m_bucket.size(); head++) {
+        int index = m_bucket[head];
+        int x = index % cols;
+        int y = index / cols;
+        uint8_t walls = grid.Walls(x, y);
+
+        for (int direction = 0; direction < 4; direction++) {
+            if (walls & (1 << direction)) continue;
+
+            int nx = x + DIRECTION_DX[direction];
+            int ny = y + DIRECTION_DY[direction];
+            if (!grid.InBounds(nx, ny) || grid.IsObstacle(nx, ny)) continue;
+
+            int next = grid.Index(nx, ny);
+            if (m_stamp[next] == m_generation) continue;
+
+            m_stamp[next] = m_generation;
+            m_cost[next] = m_cost[index] + 1;
+            m_parent[next] = index;
+            m_bucket.push_back(next);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef MAZE_SOLVER_H
+#define MAZE_SOLVER_H
+
+#include <cstdint>
+#include <vector>
+#include "maze_grid.h"
+
+// Reusable pathfinding workspace over a MazeGrid.
+// Per-cell state is tagged with a search generation, so starting a new query
+// is O(1) instead of clearing cost/visited grids. A* uses a bucket queue: with
+// unit steps and the Manhattan heuristic a neighbour's f is either the current
+// f or f + 2, so two buckets give exact ordering without a heap.
+// Buffers grow to the largest grid seen and are never reallocated after that.
+class MazeSolver {
+public:
+    // A* from start to end; obstacles block, the start cell itself never does
+    bool PathExists(const MazeGrid& grid, int startX, int startY, int endX, int endY);
+
+    // Shortest path length in steps, or -1 when the end is unreachable
+    int ShortestPathLength(const MazeGrid& grid, int startX, int startY, int endX, int endY);
+
+    // Shortest path as cell indices from end back to start; empty when unreachable
+    bool FindPath(const MazeGrid& grid, int startX, int startY, int endX, int endY, std::vector<int>& path);
+
+    // BFS from start over every reachable cell; read the results with Distance()
+    void FloodFill(const MazeGrid& grid, int startX, int startY);
+
+    // Distance found by the last search, -1 if the cell was not reached
+    int Distance(int index) const { return m_stamp[index] == m_generation ? m_cost[index] : -1; }
+
+private:
+    void BeginSearch(int cellCount);
+    int Search(const MazeGrid& grid, int start, int end);
+
+    uint32_t m_generation = 0;
+    std::vector<uint32_t> m_stamp;      // Cost valid when == m_generation
+    std::vector<uint32_t> m_closed;     // Expanded when == m_generation
+    std::vector<int> m_cost;
+    std::vector<int> m_parent;
+    std::vector<int> m_bucket;          // Open cells with f == current f
+    std::vector<int> m_nextBucket;      // Open cells with f == current f + 2
+};
+
+#endif
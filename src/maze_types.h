@@ -0,0 +1,36 @@
+#ifndef MAZE_TYPES_H
+#define MAZE_TYPES_H
+
+// Enums shared by the raylib-free maze core and the game
+
+// Difficulty levels
+enum Difficulty {
+    Easy,
+    Medium,
+    Hard
+};
+
+// Maze carving strategy
+enum class GenerationMode {
+    Serial,     // Single backtracker over the whole grid
+    Parallel    // Independent tiles carved concurrently, then stitched
+};
+
+// Maze carving algorithms (see maze_generators.h)
+enum class MazeAlgorithm {
+    Backtracker,    // Long winding corridors, few dead ends
+    Kruskal,        // Randomized Kruskal with union-find, many short dead ends
+    Prim,           // Randomized Prim, radial texture with short branches
+    Wilson,         // Uniform spanning tree via loop-erased random walks
+    BinaryTree,     // North/west bias, open top row and left column
+    Sidewinder      // Row runs with one northward exit each, open top row
+};
+
+// How ChooseExit picks among cells reachable from the start
+enum class ExitPlacement {
+    Random,             // Uniform over reachable cells at least MIN_DISTANCE away
+    DistanceWeighted,   // Same candidates, weighted by maze (path) distance
+    Farthest            // The reachable cell with the longest path from the start
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "obstacle_placer.h"
+
+ObstaclePlacer::ObstaclePlacer(MazeGrid& grid, MazeSolver& solver, int startX, int startY, int exitX, int exitY)
+    : m_grid(grid), m_solver(solver), m_start(grid.Index(startX, startY)), m_exit(grid.Index(exitX, exitY)),
+      m_onPath(grid.getCellCount(), 0) {
+    m_perfect = CheckPerfectMaze();
+    FindPath();
+}
+
+bool ObstaclePlacer::TryPlace(int x, int y) {
+    if (m_grid.IsObstacle(x, y)) return false;
+
+    // Off-path cells never affect the current route
+    if (!IsOnPath(x, y)) {
+        m_grid.SetObstacle(x, y, true);
+        return true;
+    }
+
+    // The only route of a spanning tree goes through this cell
+    if (m_perfect) return false;
+
+    // Loops exist, so look for a detour around the candidate
+    m_grid.SetObstacle(x, y, true);
+    if (FindPath()) return true;
+
+    m_grid.SetObstacle(x, y, false);
+    return false;
+}
+
+bool ObstaclePlacer::CheckPerfectMaze() {
+    const int cols = m_grid.getColumns();
+    const int rows = m_grid.getRows();
+
+    // A connected graph with exactly cells-1 passages is a spanning tree
+    long long passages = 0;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            uint8_t walls = m_grid.Walls(x, y);
+            if (x + 1 < cols && !(walls & WALL_RIGHT)) passages++;
+            if (y + 1 < rows && !(walls & WALL_BOTTOM)) passages++;
+        }
+    }
+    if (passages != m_grid.getCellCount() - 1) return false;
+
+    m_connectivity.Build(m_grid, true);
+    return m_connectivity.Flood(0, 0) == m_grid.getCellCount();
+}
+
+bool ObstaclePlacer::FindPath() {
+    const int cols = m_grid.getColumns();
+    if (!m_solver.FindPath(m_grid, m_start % cols, m_start / cols, m_exit % cols, m_exit / cols, m_newPath)) {
+        return false;
+    }
+
+    // Swap in the new route
+    for (int index : m_path) m_onPath[index] = 0;
+    m_path.swap(m_newPath);
+    for (int index : m_path) m_onPath[index] = 1;
+    return true;
+}
@@ -0,0 +1,41 @@
+#ifndef OBSTACLE_PLACER_H
+#define OBSTACLE_PLACER_H
+
+#include <vector>
+#include "maze_grid.h"
+#include "maze_solver.h"
+#include "reachability.h"
+
+// Accepts or rejects obstacle candidates while keeping start -> exit solvable.
+// The path is computed once up front. Cells off that path can never break it,
+// so they are accepted immediately. On a perfect maze (spanning tree) the path
+// is unique, so on-path cells are rejected in O(1) as well. Other mazes fall
+// back to a single re-route search, only when a candidate lands on the path.
+class ObstaclePlacer {
+public:
+    ObstaclePlacer(MazeGrid& grid, MazeSolver& solver, int startX, int startY, int exitX, int exitY);
+
+    // Places an obstacle at (x, y) if the exit stays reachable
+    bool TryPlace(int x, int y);
+
+    bool HasPath() const { return !m_path.empty(); }
+    bool IsPerfectMaze() const { return m_perfect; }
+    bool IsOnPath(int x, int y) const { return m_onPath[m_grid.Index(x, y)] != 0; }
+
+private:
+    bool CheckPerfectMaze();
+    bool FindPath();  // Routes around obstacles; replaces m_path only on success
+
+    MazeGrid& m_grid;
+    MazeSolver& m_solver;
+    int m_start;
+    int m_exit;
+    bool m_perfect;
+
+    std::vector<int> m_path;        // Cell indices from exit to start
+    std::vector<int> m_newPath;     // Candidate route while re-routing
+    std::vector<uint8_t> m_onPath;  // Per-cell membership in m_path
+    ReachabilityBitboard m_connectivity;
+};
+
+#endif
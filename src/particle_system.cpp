@@ -0,0 +1,197 @@
+#include "particle_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "rlgl.h"
+#include "sprite_batch.h"
+
+// Edge length of the generated dot texture
+const int PARTICLE_DOT_SIZE = 16;
+// Fade-in rate of particles that appear at full alpha
+const float PARTICLE_NO_FADE_IN = 1e30f;
+
+void ParticleSystem::Load(Xoshiro256 rng, int capacity) {
+    Unload();
+    m_rng = rng;
+    m_capacity = capacity;
+    for (std::vector<float>* attribute : { &m_x, &m_y, &m_velocityX, &m_velocityY,
+                                           &m_life, &m_inverseLifetime, &m_fadeInRate, &m_alpha, &m_size }) {
+        attribute->assign(capacity, 0.0f);
+    }
+    m_color.assign(capacity, BLANK);
+
+    for (int i = 0; i < PARTICLE_DIRECTIONS; i++) {
+        float angle = 2 * PI * i / PARTICLE_DIRECTIONS;
+        m_directions[i] = Vector2{ cosf(angle), sinf(angle) };
+    }
+
+    // White disc with an anti-aliased rim; particles tint it
+    Image dot = GenImageColor(PARTICLE_DOT_SIZE, PARTICLE_DOT_SIZE, BLANK);
+    Color* pixels = static_cast<Color*>(dot.data);
+    const float radius = PARTICLE_DOT_SIZE / 2.0f;
+    for (int y = 0; y < PARTICLE_DOT_SIZE; y++) {
+        for (int x = 0; x < PARTICLE_DOT_SIZE; x++) {
+            float distance = hypotf(x + 0.5f - radius, y + 0.5f - radius);
+            float coverage = std::min(std::max(radius - distance, 0.0f), 1.0f);
+            pixels[y * PARTICLE_DOT_SIZE + x] = Color{ 255, 255, 255, static_cast<unsigned char>(255 * coverage) };
+        }
+    }
+    m_dot = LoadTextureFromImage(dot);
+    UnloadImage(dot);
+    SetTextureFilter(m_dot, TEXTURE_FILTER_BILINEAR);
+}
+
+void ParticleSystem::Unload() {
+    if (m_dot.id != 0) UnloadTexture(m_dot);
+    m_dot = Texture2D{0};
+    m_count = 0;
+}
+
+int ParticleSystem::AddEmitter(const EmitterSettings& settings) {
+    Emitter emitter;
+    emitter.settings = settings;
+    m_emitters.push_back(emitter);
+    return static_cast<int>(m_emitters.size()) - 1;
+}
+
+void ParticleSystem::PlaceEmitter(int id, Vector2 center, float radius) {
+    m_emitters[id].area = Rectangle{ center.x, center.y, radius, radius };
+}
+
+void ParticleSystem::PlaceEmitter(int id, Rectangle area) {
+    m_emitters[id].area = area;
+}
+
+void ParticleSystem::SetEmitterActive(int id, bool active) {
+    Emitter& emitter = m_emitters[id];
+    if (!active) emitter.pending = 0.0f;
+    emitter.active = active;
+}
+
+void ParticleSystem::Clear() {
+    m_count = 0;
+    for (Emitter& emitter : m_emitters) emitter.pending = 0.0f;
+}
+
+void ParticleSystem::Spawn(const Emitter& emitter) {
+    const EmitterSettings& settings = emitter.settings;
+    const int i = m_count++;
+
+    if (settings.shape == EmitterShape::Disc) {
+        // Random direction and distance from the centre; area holds centre and radius
+        const Vector2 direction = m_directions[m_rng.NextInt(PARTICLE_DIRECTIONS)];
+        const float distance = m_rng.NextFloat() * emitter.area.width;
+        m_x[i] = emitter.area.x + direction.x * distance;
+        m_y[i] = emitter.area.y + direction.y * distance;
+        m_velocityX[i] = direction.x * settings.speed;
+        m_velocityY[i] = direction.y * settings.speed;
+    } else {
+        m_x[i] = emitter.area.x + m_rng.NextFloat() * emitter.area.width;
+        m_y[i] = emitter.area.y + m_rng.NextFloat() * emitter.area.height;
+        m_velocityX[i] = 0.0f;
+        m_velocityY[i] = 0.0f;
+    }
+    m_velocityX[i] += settings.drift.x + (m_rng.NextFloat() * 2 - 1) * settings.jitter.x;
+    m_velocityY[i] += settings.drift.y + (m_rng.NextFloat() * 2 - 1) * settings.jitter.y;
+
+    const float lifetime = settings.lifetime + m_rng.NextFloat() * settings.lifetimeJitter;
+    m_life[i] = lifetime;
+    m_inverseLifetime[i] = 1.0f / lifetime;
+    m_fadeInRate[i] = settings.fadeIn > 0.0f ? lifetime / settings.fadeIn : PARTICLE_NO_FADE_IN;
+    m_alpha[i] = settings.fadeIn > 0.0f ? 0.0f : 1.0f;
+    m_size[i] = settings.size;
+    m_color[i] = settings.color;
+}
+
+void ParticleSystem::Kill(int index) {
+    // Move the last live particle into the hole so the live range stays packed
+    const int last = --m_count;
+    m_x[index] = m_x[last];
+    m_y[index] = m_y[last];
+    m_velocityX[index] = m_velocityX[last];
+    m_velocityY[index] = m_velocityY[last];
+    m_life[index] = m_life[last];
+    m_inverseLifetime[index] = m_inverseLifetime[last];
+    m_fadeInRate[index] = m_fadeInRate[last];
+    m_alpha[index] = m_alpha[last];
+    m_size[index] = m_size[last];
+    m_color[index] = m_color[last];
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    const auto start = std::chrono::steady_clock::now();
+
+    for (Emitter& emitter : m_emitters) {
+        if (!emitter.active) continue;
+        emitter.pending += emitter.settings.rate * deltaTime;
+        int spawnCount = static_cast<int>(emitter.pending);
+        emitter.pending -= spawnCount;
+        spawnCount = std::min(spawnCount, m_capacity - m_count);
+        for (int i = 0; i < spawnCount; i++) Spawn(emitter);
+    }
+
+    // Branch-free passes over the packed live range
+    const int count = m_count;
+    float* __restrict x = m_x.data();
+    float* __restrict y = m_y.data();
+    const float* __restrict velocityX = m_velocityX.data();
+    const float* __restrict velocityY = m_velocityY.data();
+    float* __restrict life = m_life.data();
+    const float* __restrict inverseLifetime = m_inverseLifetime.data();
+    const float* __restrict fadeInRate = m_fadeInRate.data();
+    float* __restrict alpha = m_alpha.data();
+    for (int i = 0; i < count; i++) {
+        x[i] += velocityX[i] * deltaTime;
+        y[i] += velocityY[i] * deltaTime;
+    }
+    // Alpha falls linearly with the remaining life and, while fading in, rises with age
+    for (int i = 0; i < count; i++) {
+        life[i] -= deltaTime;
+        const float remaining = life[i] * inverseLifetime[i];
+        alpha[i] = std::min(remaining, (1.0f - remaining) * fadeInRate[i]);
+    }
+
+    // Compact: expired particles are swapped out for live ones from the end
+    for (int i = 0; i < m_count;) {
+        if (m_life[i] <= 0.0f) Kill(i);
+        else i++;
+    }
+
+    m_lastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ParticleSystem::Draw(Rectangle view) const {
+    if (m_count == 0 || m_dot.id == 0) return;
+
+    const float viewRight = view.x + view.width;
+    const float viewBottom = view.y + view.height;
+    for (int start = 0; start < m_count; start += SPRITE_BATCH_CHUNK) {
+        const int end = std::min(start + SPRITE_BATCH_CHUNK, m_count);
+
+        rlCheckRenderBatchLimit((end - start) * 4);
+        rlSetTexture(m_dot.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = start; i < end; i++) {
+            const float size = m_size[i];
+            const float left = m_x[i] - size;
+            const float top = m_y[i] - size;
+            const float right = m_x[i] + size;
+            const float bottom = m_y[i] + size;
+            if (right < view.x || left > viewRight || bottom < view.y || top > viewBottom) continue;
+
+            const Color color = m_color[i];
+            rlColor4ub(color.r, color.g, color.b, static_cast<unsigned char>(color.a * m_alpha[i]));
+            rlTexCoord2f(0.0f, 0.0f);
+            rlVertex2f(left, top);
+            rlTexCoord2f(0.0f, 1.0f);
+            rlVertex2f(left, bottom);
+            rlTexCoord2f(1.0f, 1.0f);
+            rlVertex2f(right, bottom);
+            rlTexCoord2f(1.0f, 0.0f);
+            rlVertex2f(right, top);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
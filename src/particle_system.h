@@ -0,0 +1,85 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <vector>
+#include "raylib.h"
+#include "rng.h"
+
+// Pool size shared by every emitter; enough for a screen full of ambient effects
+const int MAX_PARTICLES = 16384;
+// Spawn directions come from a table instead of cosf/sinf per particle
+const int PARTICLE_DIRECTIONS = 256;
+
+enum class EmitterShape {
+    Disc,   // Spawns inside a circle, moving outwards from its centre
+    Area    // Spawns anywhere inside a rectangle, moving with the drift
+};
+
+struct EmitterSettings {
+    EmitterShape shape = EmitterShape::Disc;
+    float rate = 60.0f;             // Particles per second
+    float lifetime = 1.0f;          // Seconds
+    float lifetimeJitter = 0.0f;    // Up to this many seconds are added at random
+    float speed = 0.0f;             // Outward speed of Disc emitters
+    Vector2 drift = {0, 0};         // Velocity added to every particle
+    Vector2 jitter = {0, 0};        // Random extra velocity in [-jitter, jitter]
+    float size = 2.0f;              // Radius in pixels
+    Color color = WHITE;            // Fades to transparent over the lifetime
+    float fadeIn = 0.0f;            // Seconds to fade in after spawning
+};
+
+// Particles of all emitters live in one structure-of-arrays pool. Live
+// particles are kept packed at the front: a dead particle is replaced by the
+// last live one, so Update() runs straight loops over contiguous floats the
+// compiler can vectorize, and Draw() submits every particle as a textured quad
+// in as few batches as rlgl allows.
+class ParticleSystem {
+public:
+    // Allocates the pool and the dot texture; needs the GL context
+    void Load(Xoshiro256 rng, int capacity = MAX_PARTICLES);
+    void Unload();
+
+    // Emitters start inactive; the returned id addresses them from then on
+    int AddEmitter(const EmitterSettings& settings);
+    // Disc emitters take a centre and radius, Area emitters a rectangle
+    void PlaceEmitter(int id, Vector2 center, float radius);
+    void PlaceEmitter(int id, Rectangle area);
+    void SetEmitterActive(int id, bool active);
+
+    void Update(float deltaTime);
+    // Only particles inside the view rectangle are submitted
+    void Draw(Rectangle view) const;
+    // Drops every live particle; emitters keep their settings
+    void Clear();
+
+    int getCount() const { return m_count; }
+    float getLastUpdateMs() const { return m_lastUpdateMs; }
+
+private:
+    struct Emitter {
+        EmitterSettings settings;
+        Rectangle area = {0, 0, 0, 0};
+        bool active = false;
+        float pending = 0.0f;       // Fractional particles carried to the next frame
+    };
+
+    void Spawn(const Emitter& emitter);
+    void Kill(int index);
+
+    // One array per attribute; the first m_count entries are live
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_velocityX, m_velocityY;
+    std::vector<float> m_life, m_inverseLifetime;
+    std::vector<float> m_fadeInRate, m_alpha, m_size;
+    std::vector<Color> m_color;
+    int m_count = 0;
+    int m_capacity = 0;
+
+    std::vector<Emitter> m_emitters;
+    Vector2 m_directions[PARTICLE_DIRECTIONS];
+    Xoshiro256 m_rng;
+    Texture2D m_dot = {0};
+    float m_lastUpdateMs = 0.0f;
+};
+
+#endif
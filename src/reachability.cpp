@@ -0,0 +1,146 @@
+#include "reachability.h"
+#include <algorithm>
+
+void ReachabilityBitboard::Build(const MazeGrid& grid, bool ignoreObstacles) {
+    m_cols = grid.getColumns();
+    m_rows = grid.getRows();
+    m_words = (m_cols + 63) / 64;
+
+    const size_t size = static_cast<size_t>(m_rows) * m_words;
+    m_intoFromWest.resize(size);
+    m_intoFromEast.resize(size);
+    m_intoFromNorth.resize(size);
+    m_intoFromSouth.resize(size);
+    m_reach.resize(size);
+
+    // Assemble each word in registers and store it once
+    for (int y = 0; y < m_rows; y++) {
+        for (int w = 0; w < m_words; w++) {
+            uint64_t west = 0, east = 0, north = 0, south = 0;
+            const int xEnd = std::min(m_cols, (w + 1) * 64);
+
+            for (int x = w * 64; x < xEnd; x++) {
+                if (!ignoreObstacles && grid.IsObstacle(x, y)) continue;
+
+                const uint64_t bit = uint64_t(1) << (x & 63);
+                const uint8_t walls = grid.Walls(x, y);
+                if (!(walls & WALL_LEFT)) west |= bit;
+                if (!(walls & WALL_RIGHT)) east |= bit;
+                if (!(walls & WALL_TOP)) north |= bit;
+                if (!(walls & WALL_BOTTOM)) south |= bit;
+            }
+
+            const size_t i = static_cast<size_t>(y) * m_words + w;
+            m_intoFromWest[i] = west;
+            m_intoFromEast[i] = east;
+            m_intoFromNorth[i] = north;
+            m_intoFromSouth[i] = south;
+        }
+    }
+
+    // Border walls are always closed, but keep the masks inside the grid regardless
+    for (int w = 0; w < m_words; w++) {
+        m_intoFromNorth[w] = 0;
+        m_intoFromSouth[static_cast<size_t>(m_rows - 1) * m_words + w] = 0;
+    }
+    for (int y = 0; y < m_rows; y++) {
+        m_intoFromWest[static_cast<size_t>(y) * m_words] &= ~uint64_t(1);
+        m_intoFromEast[static_cast<size_t>(y) * m_words + (m_cols - 1) / 64] &= ~(uint64_t(1) << ((m_cols - 1) & 63));
+    }
+}
+
+bool ReachabilityBitboard::FillRow(int row) {
+    uint64_t* reach = &m_reach[static_cast<size_t>(row) * m_words];
+    const uint64_t* west = &m_intoFromWest[static_cast<size_t>(row) * m_words];
+    const uint64_t* east = &m_intoFromEast[static_cast<size_t>(row) * m_words];
+    bool changed = false;
+
+    // Eastward: carry in from the previous word, then prefix-fill inside the word
+    for (int w = 0; w < m_words; w++) {
+        uint64_t g = reach[w];
+        if (w > 0) g |= (reach[w - 1] >> 63) & west[w];
+
+        uint64_t p = west[w];
+        g |= p & (g << 1);  p &= p << 1;
+        g |= p & (g << 2);  p &= p << 2;
+        g |= p & (g << 4);  p &= p << 4;
+        g |= p & (g << 8);  p &= p << 8;
+        g |= p & (g << 16); p &= p << 16;
+        g |= p & (g << 32);
+
+        changed |= g != reach[w];
+        reach[w] = g;
+    }
+
+    // Westward, mirrored
+    for (int w = m_words - 1; w >= 0; w--) {
+        uint64_t g = reach[w];
+        if (w + 1 < m_words) g |= ((reach[w + 1] & 1) << 63) & east[w];
+
+        uint64_t p = east[w];
+        g |= p & (g >> 1);  p &= p >> 1;
+        g |= p & (g >> 2);  p &= p >> 2;
+        g |= p & (g >> 4);  p &= p >> 4;
+        g |= p & (g >> 8);  p &= p >> 8;
+        g |= p & (g >> 16); p &= p >> 16;
+        g |= p & (g >> 32);
+
+        changed |= g != reach[w];
+        reach[w] = g;
+    }
+    return changed;
+}
+
+int ReachabilityBitboard::Flood(int startX, int startY) {
+    std::fill(m_reach.begin(), m_reach.end(), 0);
+    m_reach[static_cast<size_t>(startY) * m_words + (startX >> 6)] = uint64_t(1) << (startX & 63);
+    FillRow(startY);
+
+    // Alternate down and up sweeps. Each sweep only starts from the rows the other
+    // direction changed, and keeps going while rows keep gaining bits.
+    int downLo = startY, downHi = startY;
+    int upLo = startY, upHi = startY;
+    m_sweeps = 0;
+
+    while (downLo <= downHi || upLo <= upHi) {
+        m_sweeps++;
+
+        bool carrying = false;
+        for (int y = std::max(downLo + 1, 1); y < m_rows && (carrying || y <= downHi + 1); y++) {
+            carrying = false;
+            for (int w = 0; w < m_words; w++) {
+                size_t i = static_cast<size_t>(y) * m_words + w;
+                uint64_t incoming = m_reach[i - m_words] & m_intoFromNorth[i] & ~m_reach[i];
+                if (incoming) { m_reach[i] |= incoming; carrying = true; }
+            }
+            if (carrying) {
+                FillRow(y);
+                upLo = std::min(upLo, y);
+                upHi = std::max(upHi, y);
+            }
+        }
+        downLo = m_rows;
+        downHi = -1;
+
+        carrying = false;
+        for (int y = std::min(upHi - 1, m_rows - 2); y >= 0 && (carrying || y >= upLo - 1); y--) {
+            carrying = false;
+            for (int w = 0; w < m_words; w++) {
+                size_t i = static_cast<size_t>(y) * m_words + w;
+                uint64_t incoming = m_reach[i + m_words] & m_intoFromSouth[i] & ~m_reach[i];
+                if (incoming) { m_reach[i] |= incoming; carrying = true; }
+            }
+            if (carrying) {
+                FillRow(y);
+                downLo = std::min(downLo, y);
+                downHi = std::max(downHi, y);
+            }
+        }
+        upLo = m_rows;
+        upHi = -1;
+    }
+
+    int count = 0;
+    for (uint64_t word : m_reach) count += __builtin_popcountll(word);
+    return count;
+}
@@ -0,0 +1,42 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <cstdint>
+#include <vector>
+#include "maze_grid.h"
+
+// Bit-parallel flood fill over per-row passage masks.
+// Each row is a few 64-bit words. Horizontal spread is a Kogge-Stone prefix fill
+// (six shift/AND steps per word). Vertical spread is a single AND with the row
+// below or above. Down and up sweeps repeat until nothing changes, which yields
+// the full reachable set at once instead of answering one start/end query.
+class ReachabilityBitboard {
+public:
+    // Rebuilds the passage masks; obstacles block unless ignoreObstacles is set
+    void Build(const MazeGrid& grid, bool ignoreObstacles = false);
+
+    // Floods from (startX, startY) and returns the number of reachable cells
+    int Flood(int startX, int startY);
+
+    bool IsReachable(int x, int y) const {
+        return (m_reach[y * m_words + (x >> 6)] >> (x & 63)) & 1;
+    }
+    int getSweeps() const { return m_sweeps; }
+
+private:
+    bool FillRow(int row);  // Spreads along the row; true if any bit was added
+
+    int m_cols = 0;
+    int m_rows = 0;
+    int m_words = 0;
+    int m_sweeps = 0;
+
+    // All masks are m_rows * m_words words, bit x of a row = column x
+    std::vector<uint64_t> m_intoFromWest;   // Step from x-1 into x is open
+    std::vector<uint64_t> m_intoFromEast;   // Step from x+1 into x is open
+    std::vector<uint64_t> m_intoFromNorth;  // Step from row-1 into row is open
+    std::vector<uint64_t> m_intoFromSouth;  // Step from row+1 into row is open
+    std::vector<uint64_t> m_reach;
+};
+
+#endif
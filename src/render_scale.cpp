@@ -0,0 +1,71 @@
+#include "render_scale.h"
+#include <algorithm>
+#include <cmath>
+
+// Rolling frame time above budget by this factor lowers the resolution
+const float RENDER_SCALE_OVER_BUDGET = 1.1f;
+// ...and within it by this factor counts towards raising it again
+const float RENDER_SCALE_UNDER_BUDGET = 1.02f;
+
+void DynamicResolution::Update(float frameTime) {
+    const float frameMs = frameTime * 1000.0f;
+    m_averageMs = m_averageMs == 0.0f ? frameMs : m_averageMs + (frameMs - m_averageMs) * FRAME_TIME_SMOOTHING;
+
+    m_sinceChange += frameTime;
+    if (m_averageMs <= m_budgetMs * RENDER_SCALE_UNDER_BUDGET) m_withinBudget += frameTime;
+    else m_withinBudget = 0.0f;
+    if (m_sinceChange < RENDER_SCALE_SETTLE_TIME) return;
+
+    float scale = m_scale;
+    if (m_averageMs > m_budgetMs * RENDER_SCALE_OVER_BUDGET) {
+        scale = std::max(m_scale - RENDER_SCALE_STEP, MIN_RENDER_SCALE);
+    } else if (m_withinBudget >= RENDER_SCALE_RECOVER_TIME) {
+        scale = std::min(m_scale + RENDER_SCALE_STEP, MAX_RENDER_SCALE);
+    }
+    if (scale != m_scale) {
+        m_scale = scale;
+        m_sinceChange = 0.0f;
+        m_withinBudget = 0.0f;
+    }
+}
+
+Camera2D DynamicResolution::Begin(const Camera2D& camera, int width, int height) {
+    if (m_target.id == 0 || m_target.texture.width != width || m_target.texture.height != height) {
+        Unload();
+        m_target = LoadRenderTexture(width, height);
+        SetTextureFilter(m_target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    BeginTextureMode(m_target);
+
+    // Same view, fewer pixels: shrinking offset and zoom together maps it into the scaled corner
+    Camera2D scaled = camera;
+    scaled.offset.x *= m_scale;
+    scaled.offset.y *= m_scale;
+    scaled.zoom *= m_scale;
+    return scaled;
+}
+
+void DynamicResolution::End() {
+    EndTextureMode();
+
+    // Render targets are stored bottom-up, so the drawn corner is the top
+    // of the texture and is read with a negative height to flip it
+    const float width = static_cast<float>(m_target.texture.width);
+    const float height = static_cast<float>(m_target.texture.height);
+    const float scaledWidth = std::round(width * m_scale);
+    const float scaledHeight = std::round(height * m_scale);
+    DrawTexturePro(m_target.texture, Rectangle{ 0, height - scaledHeight, scaledWidth, -scaledHeight },
+                   Rectangle{ 0, 0, width, height }, Vector2{ 0, 0 }, 0.0f, WHITE);
+}
+
+void DynamicResolution::Reset() {
+    m_scale = MAX_RENDER_SCALE;
+    m_averageMs = 0.0f;
+    m_sinceChange = 0.0f;
+    m_withinBudget = 0.0f;
+}
+
+void DynamicResolution::Unload() {
+    if (m_target.id != 0) UnloadRenderTexture(m_target);
+    m_target = RenderTexture2D{0};
+}
@@ -0,0 +1,54 @@
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+#include "raylib.h"
+
+// Frame time the adaptive mode aims for unless --frame-budget says otherwise
+const float DEFAULT_FRAME_BUDGET_MS = 1000.0f / 60.0f;
+// Playfield resolution bounds, as a fraction of the window
+const float MIN_RENDER_SCALE = 0.5f;
+const float MAX_RENDER_SCALE = 1.0f;
+const float RENDER_SCALE_STEP = 0.05f;
+// Weight of the newest frame in the rolling frame time
+const float FRAME_TIME_SMOOTHING = 0.1f;
+// Minimum time between two scale changes, so each one gets measured
+const float RENDER_SCALE_SETTLE_TIME = 0.5f;
+// Time the frame time must stay within budget before resolution is raised again
+const float RENDER_SCALE_RECOVER_TIME = 2.0f;
+
+// Adaptive playfield resolution. The playfield is drawn into the top-left
+// part of a window-sized render target and stretched over the window, so
+// only the scale changes at runtime and the target is never reallocated.
+// The scale drops one step while the rolling frame time is over budget and
+// creeps back up once it has stayed under budget for a while; under vsync
+// frames never come in below the refresh interval, so rising is a probe
+// that the next measurement confirms or undoes.
+class DynamicResolution {
+public:
+    // Feeds the wall-clock length of the last whole loop in seconds, vsync wait
+    // included; a span that leaves out rendering never shows the load
+    void Update(float frameTime);
+    // Starts drawing into the scaled target and returns the camera to use
+    // in place of the world camera. Must not be called inside texture mode.
+    Camera2D Begin(const Camera2D& camera, int width, int height);
+    // Stops drawing into the target and stretches it over the window
+    void End();
+    // Back to full resolution with no frame history
+    void Reset();
+    void Unload();
+
+    float getScale() const { return m_scale; }
+    float getBudgetMs() const { return m_budgetMs; }
+    void setBudgetMs(float budgetMs) { m_budgetMs = budgetMs; }
+    float getAverageFrameMs() const { return m_averageMs; }
+
+private:
+    RenderTexture2D m_target = {0};
+    float m_scale = MAX_RENDER_SCALE;
+    float m_budgetMs = DEFAULT_FRAME_BUDGET_MS;
+    float m_averageMs = 0.0f;
+    float m_sinceChange = 0.0f;
+    float m_withinBudget = 0.0f;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include "resource_manager.h"
+#include <utility>
+
+void ResourceManager::SetBudget(size_t vramBytes, size_t ramBytes) {
+    m_vramBudget = vramBytes;
+    m_ramBudget = ramBytes;
+    Trim();
+}
+
+int ResourceManager::Acquire(const std::string& key, ResourceKind kind) {
+    auto found = m_slotsByKey.find(key);
+    if (found == m_slotsByKey.end() || m_entries[found->second].kind != kind) {
+        m_stats.misses++;
+        return -1;
+    }
+
+    Entry& entry = m_entries[found->second];
+    if (entry.references++ == 0) m_stats.referenced++;
+    entry.lastUse = ++m_useClock;
+    m_stats.hits++;
+    return found->second;
+}
+
+TextureHandle ResourceManager::AcquireTexture(const std::string& key) {
+    const int slot = Acquire(key, ResourceKind::Texture);
+    return slot < 0 ? TextureHandle() : TextureHandle{ slot, m_entries[slot].generation };
+}
+
+SoundHandle ResourceManager::AcquireSound(const std::string& key) {
+    const int slot = Acquire(key, ResourceKind::Sound);
+    return slot < 0 ? SoundHandle() : SoundHandle{ slot, m_entries[slot].generation };
+}
+
+MusicHandle ResourceManager::AcquireMusic(const std::string& key) {
+    const int slot = Acquire(key, ResourceKind::Music);
+    return slot < 0 ? MusicHandle() : MusicHandle{ slot, m_entries[slot].generation };
+}
+
+int ResourceManager::Insert(const std::string& key, ResourceKind kind) {
+    // A key loaded twice replaces the older copy
+    auto found = m_slotsByKey.find(key);
+    if (found != m_slotsByKey.end()) Unload(found->second);
+
+    int slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(m_entries.size());
+        m_entries.emplace_back();
+    }
+
+    Entry& entry = m_entries[slot];
+    const uint32_t generation = entry.generation + 1;
+    entry = Entry{};
+    entry.key = key;
+    entry.kind = kind;
+    entry.live = true;
+    entry.generation = generation;
+    entry.references = 1;
+    entry.lastUse = ++m_useClock;
+    m_slotsByKey[key] = slot;
+    m_stats.resident++;
+    m_stats.referenced++;
+    return slot;
+}
+
+TextureHandle ResourceManager::AddTexture(const std::string& key, Texture2D texture, std::function<void()> unload) {
+    const int slot = Insert(key, ResourceKind::Texture);
+    Entry& entry = m_entries[slot];
+    entry.texture = texture;
+    entry.vramBytes = static_cast<size_t>(GetPixelDataSize(texture.width, texture.height, texture.format));
+    entry.unload = std::move(unload);
+    m_stats.vramBytes += entry.vramBytes;
+    Trim();
+    return TextureHandle{ slot, entry.generation };
+}
+
+SoundHandle ResourceManager::AddSound(const std::string& key, Sound sound) {
+    const int slot = Insert(key, ResourceKind::Sound);
+    Entry& entry = m_entries[slot];
+    entry.sound = sound;
+    entry.ramBytes = static_cast<size_t>(sound.frameCount) * sound.stream.channels * (sound.stream.sampleSize / 8);
+    m_stats.ramBytes += entry.ramBytes;
+    Trim();
+    return SoundHandle{ slot, entry.generation };
+}
+
+MusicHandle ResourceManager::AddMusic(const std::string& key, Music music, size_t ramBytes, std::function<void()> unload) {
+    const int slot = Insert(key, ResourceKind::Music);
+    Entry& entry = m_entries[slot];
+    entry.music = music;
+    entry.ramBytes = ramBytes;
+    entry.unload = std::move(unload);
+    m_stats.ramBytes += entry.ramBytes;
+    Trim();
+    return MusicHandle{ slot, entry.generation };
+}
+
+void ResourceManager::ReleaseSlot(int slot, uint32_t generation) {
+    if (slot < 0 || slot >= static_cast<int>(m_entries.size())) return;
+    Entry& entry = m_entries[slot];
+    if (!entry.live || entry.generation != generation || entry.references == 0) return;
+
+    // In use until now, so it ages from here rather than from when it was acquired
+    entry.lastUse = ++m_useClock;
+    if (--entry.references == 0) m_stats.referenced--;
+    Trim();
+}
+
+void ResourceManager::Unload(int slot) {
+    Entry& entry = m_entries[slot];
+    if (entry.unload) {
+        entry.unload();
+    } else {
+        switch (entry.kind) {
+            case ResourceKind::Texture: UnloadTexture(entry.texture); break;
+            case ResourceKind::Sound: UnloadSound(entry.sound); break;
+            case ResourceKind::Music: UnloadMusicStream(entry.music); break;
+        }
+    }
+
+    m_stats.resident--;
+    if (entry.references > 0) m_stats.referenced--;
+    m_stats.vramBytes -= entry.vramBytes;
+    m_stats.ramBytes -= entry.ramBytes;
+    m_slotsByKey.erase(entry.key);
+    m_freeSlots.push_back(slot);
+
+    // Keep the generation so stale handles never match the next occupant
+    const uint32_t generation = entry.generation;
+    entry = Entry{};
+    entry.generation = generation;
+}
+
+void ResourceManager::Trim() {
+    // A few dozen entries at most, so a scan for the oldest is cheaper than keeping a list
+    while (m_stats.vramBytes > m_vramBudget || m_stats.ramBytes > m_ramBudget) {
+        const bool overVram = m_stats.vramBytes > m_vramBudget;
+        const bool overRam = m_stats.ramBytes > m_ramBudget;
+        int oldest = -1;
+        for (int i = 0; i < static_cast<int>(m_entries.size()); i++) {
+            const Entry& entry = m_entries[i];
+            if (!entry.live || entry.references > 0) continue;
+            if (!(overVram && entry.vramBytes > 0) && !(overRam && entry.ramBytes > 0)) continue;
+            if (oldest < 0 || entry.lastUse < m_entries[oldest].lastUse) oldest = i;
+        }
+        // Everything over budget is in use
+        if (oldest < 0) return;
+
+        Unload(oldest);
+        m_stats.evictions++;
+    }
+}
+
+void ResourceManager::Clear() {
+    for (int i = 0; i < static_cast<int>(m_entries.size()); i++) {
+        if (m_entries[i].live) Unload(i);
+    }
+}
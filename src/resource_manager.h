@@ -0,0 +1,124 @@
+#ifndef RESOURCE_MANAGER_H
+#define RESOURCE_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "raylib.h"
+
+// Cache budgets unless --vram-budget / --ram-budget say otherwise
+const size_t DEFAULT_VRAM_BUDGET = 64u << 20;
+const size_t DEFAULT_RAM_BUDGET = 32u << 20;
+
+enum class ResourceKind {
+    Texture,
+    Sound,
+    Music
+};
+
+// Names one resident resource. Handles go stale when their resource is
+// evicted; the generation tells a stale handle from the slot's new occupant.
+template <ResourceKind Kind>
+struct ResourceHandle {
+    int slot = -1;
+    uint32_t generation = 0;
+    bool IsValid() const { return slot >= 0; }
+};
+
+using TextureHandle = ResourceHandle<ResourceKind::Texture>;
+using SoundHandle = ResourceHandle<ResourceKind::Sound>;
+using MusicHandle = ResourceHandle<ResourceKind::Music>;
+
+struct ResourceStats {
+    long long hits = 0;             // Acquires served from the cache
+    long long misses = 0;           // Acquires the caller had to load for
+    long long evictions = 0;
+    int resident = 0;
+    int referenced = 0;             // Resident and held by at least one handle
+    size_t vramBytes = 0;
+    size_t ramBytes = 0;
+};
+
+// Reference-counted resources by key. Released resources stay resident and
+// are only evicted, least recently used first, once textures exceed the VRAM
+// budget or sounds and music exceed the RAM budget, so loading something
+// that was used a moment ago is a cache hit.
+//
+// Acquire*() takes a reference to a resident resource or returns an invalid
+// handle (a miss); the caller then loads the resource itself, possibly over
+// several frames, and hands it over with Add*(), which also takes a reference.
+// The optional unload function replaces the default Unload* call, for
+// resources that own more than the raylib object.
+class ResourceManager {
+public:
+    void SetBudget(size_t vramBytes, size_t ramBytes);
+    size_t getVramBudget() const { return m_vramBudget; }
+    size_t getRamBudget() const { return m_ramBudget; }
+
+    TextureHandle AcquireTexture(const std::string& key);
+    SoundHandle AcquireSound(const std::string& key);
+    MusicHandle AcquireMusic(const std::string& key);
+
+    TextureHandle AddTexture(const std::string& key, Texture2D texture, std::function<void()> unload = nullptr);
+    SoundHandle AddSound(const std::string& key, Sound sound);
+    // Music streams read their encoded data as they play; ramBytes counts it when the stream owns it
+    MusicHandle AddMusic(const std::string& key, Music music, size_t ramBytes, std::function<void()> unload = nullptr);
+
+    // Drops a reference and resets the handle
+    template <ResourceKind Kind>
+    void Release(ResourceHandle<Kind>& handle) {
+        ReleaseSlot(handle.slot, handle.generation);
+        handle = ResourceHandle<Kind>();
+    }
+
+    template <ResourceKind Kind>
+    bool IsResident(const ResourceHandle<Kind>& handle) const {
+        return handle.slot >= 0 && handle.slot < static_cast<int>(m_entries.size()) &&
+               m_entries[handle.slot].live && m_entries[handle.slot].generation == handle.generation;
+    }
+
+    // Only for handles still holding their reference
+    const Texture2D& Get(TextureHandle handle) const { return m_entries[handle.slot].texture; }
+    const Sound& Get(SoundHandle handle) const { return m_entries[handle.slot].sound; }
+    const Music& Get(MusicHandle handle) const { return m_entries[handle.slot].music; }
+
+    // Unloads everything, referenced or not
+    void Clear();
+    const ResourceStats& getStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        std::string key;
+        ResourceKind kind = ResourceKind::Texture;
+        bool live = false;
+        uint32_t generation = 0;
+        int references = 0;
+        unsigned long long lastUse = 0;
+        size_t vramBytes = 0;
+        size_t ramBytes = 0;
+        Texture2D texture = {0};
+        Sound sound = {0};
+        Music music = {0};
+        std::function<void()> unload;
+    };
+
+    int Acquire(const std::string& key, ResourceKind kind);
+    int Insert(const std::string& key, ResourceKind kind);
+    void ReleaseSlot(int slot, uint32_t generation);
+    void Unload(int slot);
+    // Evicts unreferenced entries, oldest first, until both budgets hold
+    void Trim();
+
+    std::vector<Entry> m_entries;
+    std::vector<int> m_freeSlots;
+    std::unordered_map<std::string, int> m_slotsByKey;
+    unsigned long long m_useClock = 0;
+    size_t m_vramBudget = DEFAULT_VRAM_BUDGET;
+    size_t m_ramBudget = DEFAULT_RAM_BUDGET;
+    ResourceStats m_stats;
+};
+
+#endif
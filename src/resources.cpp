@@ -1,28 +1,18 @@
 #include "resources.h"
+#include "asset_archive.h"
+#include "asset_stream.h"
 #include "game_state.h"
-#include <random>
 
 namespace GameResources {
     // Global resource variables
-    Texture2D spaceshipTexture;
-    Texture2D portalPlaceholder;
-    Texture2D asteroidSpritesheet;
+    SpriteAtlas fallbackAtlas;
+    SpriteBatch spriteBatch;
+    ParticleSystem particles;
+
     Music spaceAmbient;
-    
-    Texture2D monkeyTexture;
-    Texture2D bananaTexture;
-    Texture2D logsSpritesheet;
     Music jungleAmbient;
-    
-    Texture2D camelTexture;
-    Texture2D oasisTexture;
-    Texture2D cactusTexture;
-    Texture2D tumbleweedTexture;
     Music desertAmbient;
     
-    Texture2D timeBonusTexture;
-    Texture2D speedBoostTexture;
-    
     Sound startSound;
     Sound blockedSound;
     Sound winSound;
@@ -30,93 +20,377 @@ namespace GameResources {
     Sound menuSound;
     Sound bonusSound;
 
-    bool spaceResourcesLoaded = false;
-    bool jungleResourcesLoaded = false;
-    bool desertResourcesLoaded = false;
+    ResourceManager resourceManager;
+    SfxPool sfx;
+
+    bool fallbackSpritesLoaded = false;
     bool powerupResourcesLoaded = false;
     bool generalSoundsLoaded = false;
-    
-    // Resource loading functions
-    void LoadSpaceResources() {
-        if (!spaceResourcesLoaded) {
-            spaceshipTexture = LoadTexture("Assets/spaceship.png");
-            asteroidSpritesheet = LoadTexture("Assets/asteroids_spritesheet.png");
-            spaceAmbient = LoadMusicStream("sounds/space_ambient.wav");
-            
-            // Generate portal texture
-            Image portalImage = GenImageColor(64, 64, BLANK);
-            ImageDrawCircle(&portalImage, 32, 32, 30, SKYBLUE);
-            portalPlaceholder = LoadTextureFromImage(portalImage);
-            UnloadImage(portalImage);
-            
-            spaceResourcesLoaded = true;
+    SoundHandle bonusSoundHandle;
+    SoundHandle generalSoundHandles[5];
+}
+
+namespace {
+    enum class ThemeLoadState {
+        Released,       // Not in use; its atlas and music may still sit in the resource cache
+        Decoding,       // A worker owns the assets while it reads and packs what was not cached
+        Uploading,      // Packed atlas going to the GPU a slice per frame
+        Held            // References on the atlas and music, which are drawn and played
+    };
+
+    // Everything one theme streams in
+    struct ThemeAssets {
+        SpriteAtlas atlas;                          // Owned by the cached texture entry once added
+        TextureHandle atlasHandle;
+        MusicHandle musicHandle;
+        bool loadAtlas = false;                     // Cache misses the current load fills in
+        bool loadMusic = false;
+        const unsigned char* musicData = nullptr;   // Encoded track; the music stream reads it while playing
+        int musicSize = 0;
+        const char* musicType = ".wav";
+        bool ownsMusicData = false;                 // Read from a loose file rather than the archive
+        ThemeLoadState state = ThemeLoadState::Released;
+    };
+
+    const int THEME_COUNT = 3;
+    ThemeAssets themes[THEME_COUNT];
+    AssetStreamer streamer;
+    // Assets come from here when it is open and holds them, from loose files otherwise
+    AssetArchive archive;
+
+    // Voices, cooldown and priority per effect. Bumping into an obstacle
+    // repeats every frame a key is held, so it gets the longest cooldown and
+    // gives way to everything else.
+    const SfxSettings SFX_SETTINGS[static_cast<int>(SfxId::Count)] = {
+        { 1, 0.0f, SfxPriority::High },     // Start
+        { 1, 0.25f, SfxPriority::Low },     // Blocked
+        { 1, 0.0f, SfxPriority::High },     // Win
+        { 1, 0.0f, SfxPriority::High },     // Lose
+        { 2, 0.05f, SfxPriority::Normal },  // Menu
+        { 3, 0.08f, SfxPriority::Normal },  // Bonus
+    };
+
+    void SetSfx(SfxId id, Sound sound) {
+        GameResources::sfx.Set(id, sound, SFX_SETTINGS[static_cast<int>(id)]);
+    }
+
+    GameTheme lastTheme = static_cast<GameTheme>(-1); // Initialize with an invalid theme
+    // Rolled ahead by PrefetchNextTheme() and used by the next RandomizeTheme()
+    bool hasNextTheme = false;
+    GameTheme nextTheme = GameTheme::Jungle;
+
+    ThemeAssets& Assets(GameTheme theme) {
+        return themes[static_cast<int>(theme)];
+    }
+
+    const char* ThemeName(GameTheme theme) {
+        switch (theme) {
+            case GameTheme::Space: return "space";
+            case GameTheme::Jungle: return "jungle";
+            default: return "desert";
         }
     }
-    
-    void UnloadSpaceResources() {
-        if (spaceResourcesLoaded) {
-            UnloadTexture(spaceshipTexture);
-            UnloadTexture(portalPlaceholder);
-            UnloadTexture(asteroidSpritesheet);
-            UnloadMusicStream(spaceAmbient);
-
-            spaceResourcesLoaded = false;
+
+    // Resource cache keys
+    std::string AtlasKey(GameTheme theme) {
+        return std::string("atlas/") + ThemeName(theme);
+    }
+
+    std::string MusicKey(GameTheme theme) {
+        return std::string("music/") + ThemeName(theme);
+    }
+
+    Music& ThemeMusic(GameTheme theme) {
+        switch (theme) {
+            case GameTheme::Space: return GameResources::spaceAmbient;
+            case GameTheme::Jungle: return GameResources::jungleAmbient;
+            default: return GameResources::desertAmbient;
         }
     }
-    
-    void LoadJungleResources() {
-        if (!jungleResourcesLoaded) {
-            monkeyTexture = LoadTexture("Assets/monkey.png");
-            bananaTexture = LoadTexture("Assets/bananas.png");
-            logsSpritesheet = LoadTexture("Assets/logs_spritesheet.png");
-            jungleAmbient = LoadMusicStream("sounds/jungle_ambient.wav");
-            
-            jungleResourcesLoaded = true;
+
+    // Kept resident: the theme on screen and the one prefetched for the next round
+    bool IsWanted(GameTheme theme) {
+        return theme == GAME_STATE.getCurrentTheme() || (hasNextTheme && theme == nextTheme);
+    }
+
+    void PlayThemeMusic(GameTheme theme) {
+        if (GAME_STATE.getSoundSettings() != SoundSettings::MusicOff && GAME_STATE.getSoundSettings() != SoundSettings::AllOff) {
+            PlayMusicStream(ThemeMusic(theme));
+            SetMusicVolume(ThemeMusic(theme), 1.0f);
+        }
+    }
+
+    GameTheme RollTheme() {
+        GameTheme newTheme;
+        do {
+            newTheme = static_cast<GameTheme>(GAME_STATE.getRandom().Stream(RngStream::Theme).NextInt(3));
+        } while (newTheme == lastTheme);
+        return newTheme;
+    }
+
+    const AssetEntry* FindAsset(const char* fileName, AssetKind kind) {
+        if (!archive.IsOpen()) return nullptr;
+        const AssetEntry* entry = archive.Find(fileName);
+        return entry != nullptr && entry->kind == kind ? entry : nullptr;
+    }
+
+    // Packed pixels are lent to the atlas straight from the mapping; compressed ones are unpacked into a copy
+    void AddSprite(SpriteAtlas& atlas, SpriteId id, const char* fileName, int columns = 1, int rows = 1) {
+        const AssetEntry* entry = FindAsset(fileName, AssetKind::Image);
+        if (entry == nullptr) {
+            atlas.Add(id, fileName, columns, rows);
+            return;
+        }
+
+        Image image = { nullptr, static_cast<int>(entry->width), static_cast<int>(entry->height), 1,
+                        PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        if (entry->codec == AssetCodec::None) {
+            image.data = const_cast<unsigned char*>(archive.Data(*entry));
+            atlas.Add(id, image, columns, rows, false);
+            return;
+        }
+        int size = 0;
+        image.data = DecompressData(archive.Data(*entry), static_cast<int>(entry->size), &size);
+        if (image.data == nullptr || size != static_cast<int>(entry->rawSize)) {
+            TraceLog(LOG_WARNING, "ASSETS: [%s] Packed pixels are corrupt, loading the loose file", fileName);
+            MemFree(image.data);
+            atlas.Add(id, fileName, columns, rows);
+            return;
+        }
+        atlas.Add(id, image, columns, rows);
+    }
+
+    Sound LoadSoundAsset(const char* fileName) {
+        const AssetEntry* entry = FindAsset(fileName, AssetKind::Audio);
+        if (entry == nullptr) return LoadSound(fileName);
+
+        Wave wave = LoadWaveFromMemory(entry->fileType, archive.Data(*entry), static_cast<int>(entry->size));
+        Sound sound = LoadSoundFromWave(wave);
+        UnloadWave(wave);
+        return sound;
+    }
+
+    // Powerup sprites are shared by all themes, so every theme atlas carries them
+    void AddPowerupSprites(SpriteAtlas& atlas) {
+        AddSprite(atlas, SpriteId::TimeBonus, "Assets/timeBonus.png");
+        AddSprite(atlas, SpriteId::SpeedBoost, "Assets/speedBoost.png");
+    }
+
+    const char* MusicFile(GameTheme theme) {
+        switch (theme) {
+            case GameTheme::Space: return "sounds/space_ambient.wav";
+            case GameTheme::Jungle: return "sounds/jungle_ambient.wav";
+            default: return "sounds/desert_ambient.wav";
+        }
+    }
+
+    // Sound effects are shared through the cache; the handle holds the reference
+    Sound HoldSound(const char* fileName, SoundHandle& handle) {
+        ResourceManager& manager = GameResources::resourceManager;
+        handle = manager.AcquireSound(fileName);
+        if (!handle.IsValid()) handle = manager.AddSound(fileName, LoadSoundAsset(fileName));
+        return manager.Get(handle);
+    }
+
+    void PackThemeSprites(GameTheme theme, SpriteAtlas& atlas) {
+        switch (theme) {
+            case GameTheme::Space: {
+                AddSprite(atlas, SpriteId::Player, "Assets/spaceship.png");
+                AddSprite(atlas, SpriteId::Obstacle, "Assets/asteroids_spritesheet.png", ASTEROID_SPRITE_COLUMNS, ASTEROID_SPRITE_ROWS);
+
+                // Generate portal sprite
+                Image portalImage = GenImageColor(64, 64, BLANK);
+                ImageDrawCircle(&portalImage, 32, 32, 30, SKYBLUE);
+                atlas.Add(SpriteId::Goal, portalImage);
+                break;
+            }
+            case GameTheme::Jungle:
+                AddSprite(atlas, SpriteId::Player, "Assets/monkey.png");
+                AddSprite(atlas, SpriteId::Goal, "Assets/bananas.png");
+                AddSprite(atlas, SpriteId::Obstacle, "Assets/logs_spritesheet.png", LOG_SPRITE_COLUMNS, LOG_SPRITE_ROWS);
+                break;
+            case GameTheme::Desert:
+                AddSprite(atlas, SpriteId::Player, "Assets/camel.png");
+                AddSprite(atlas, SpriteId::Goal, "Assets/oasis.png");
+                AddSprite(atlas, SpriteId::Obstacle, "Assets/cactus.png");
+                AddSprite(atlas, SpriteId::ObstacleAlt, "Assets/tumbleweed.png");
+                break;
+        }
+        AddPowerupSprites(atlas);
+        atlas.PackImage();
+    }
+
+    // Worker side, CPU only: decodes and packs the sprites and reads the music
+    // file, skipping whatever the resource cache still holds
+    void DecodeTheme(GameTheme theme, ThemeAssets& assets) {
+        if (assets.loadAtlas) PackThemeSprites(theme, assets.atlas);
+        if (!assets.loadMusic) return;
+
+        // Archived tracks are streamed from the mapping itself
+        const char* musicFile = MusicFile(theme);
+        const AssetEntry* music = FindAsset(musicFile, AssetKind::Audio);
+        if (music != nullptr) {
+            assets.musicData = archive.Data(*music);
+            assets.musicSize = static_cast<int>(music->size);
+            assets.musicType = music->fileType;
+            assets.ownsMusicData = false;
+        } else {
+            assets.musicData = LoadFileData(musicFile, &assets.musicSize);
+            assets.musicType = ".wav";
+            assets.ownsMusicData = true;
+        }
+    }
+
+    // Main thread, once the theme's atlas and music are both held
+    void HoldTheme(GameTheme theme, ThemeAssets& assets) {
+        assets.state = ThemeLoadState::Held;
+        ThemeMusic(theme) = GameResources::resourceManager.Get(assets.musicHandle);
+
+        // Chunks cached with the fallback shapes are redrawn with the real sprites
+        if (theme == GAME_STATE.getCurrentTheme()) {
+            GAME_STATE.setMazeLayerDirty(true);
+            PlayThemeMusic(theme);
+        }
+    }
+
+    // Main thread, once the atlas is on the GPU: hands the new parts to the cache
+    void FinishTheme(GameTheme theme, ThemeAssets& assets) {
+        ResourceManager& manager = GameResources::resourceManager;
+        if (assets.loadAtlas) {
+            assets.atlasHandle = manager.AddTexture(AtlasKey(theme), assets.atlas.getTexture(),
+                                                    [&assets]() { assets.atlas.Unload(); });
+        }
+        if (assets.loadMusic) {
+            // A missing track is cached as silence so it is not looked for again
+            const Music music = assets.musicData != nullptr
+                ? LoadMusicStreamFromMemory(assets.musicType, assets.musicData, assets.musicSize) : Music{};
+            const unsigned char* data = assets.musicData;
+            const bool ownsData = assets.ownsMusicData;
+            assets.musicHandle = manager.AddMusic(MusicKey(theme), music, ownsData ? assets.musicSize : 0,
+                                                  [music, data, ownsData]() {
+                                                      UnloadMusicStream(music);
+                                                      if (ownsData) UnloadFileData(const_cast<unsigned char*>(data));
+                                                  });
+        }
+        assets.musicData = nullptr;
+        assets.musicSize = 0;
+        assets.loadAtlas = false;
+        assets.loadMusic = false;
+        HoldTheme(theme, assets);
+    }
+}
+
+namespace GameResources {
+    bool OpenAssetArchive(const char* fileName) {
+        if (!archive.Open(fileName)) {
+            TraceLog(LOG_INFO, "ASSETS: [%s] No usable archive, loading loose files", fileName);
+            return false;
+        }
+        TraceLog(LOG_INFO, "ASSETS: [%s] Mapped archive with %d assets", fileName, archive.getEntryCount());
+        return true;
+    }
+
+    void RequestTheme(GameTheme theme) {
+        ThemeAssets& assets = Assets(theme);
+        if (assets.state != ThemeLoadState::Released) return;
+
+        // Whatever is still cached is a reference away; only the rest is loaded
+        assets.atlasHandle = resourceManager.AcquireTexture(AtlasKey(theme));
+        assets.musicHandle = resourceManager.AcquireMusic(MusicKey(theme));
+        assets.loadAtlas = !assets.atlasHandle.IsValid();
+        assets.loadMusic = !assets.musicHandle.IsValid();
+        if (!assets.loadAtlas && !assets.loadMusic) {
+            HoldTheme(theme, assets);
+            return;
         }
+
+        assets.state = ThemeLoadState::Decoding;
+        streamer.Submit([theme, &assets]() { DecodeTheme(theme, assets); },
+                        [theme, &assets]() {
+                            if (assets.loadAtlas) assets.state = ThemeLoadState::Uploading;
+                            else FinishTheme(theme, assets);
+                            // Switched away while it was decoding
+                            if (!IsWanted(theme)) ReleaseTheme(theme);
+                        });
     }
 
-    void UnloadJungleResources() {
-        if (jungleResourcesLoaded) {
-            UnloadTexture(monkeyTexture);
-            UnloadTexture(bananaTexture);
-            UnloadTexture(logsSpritesheet);
-            UnloadMusicStream(jungleAmbient);
+    void ReleaseTheme(GameTheme theme) {
+        ThemeAssets& assets = Assets(theme);
+        // The worker still writes into it; it is released once its job finishes unwanted
+        if (assets.state == ThemeLoadState::Decoding || assets.state == ThemeLoadState::Released) return;
 
-            jungleResourcesLoaded = false;
+        if (assets.state == ThemeLoadState::Uploading) {
+            // Never reached the cache, so nothing else will free it
+            if (assets.loadAtlas) assets.atlas.Unload();
+            if (assets.musicData != nullptr && assets.ownsMusicData) UnloadFileData(const_cast<unsigned char*>(assets.musicData));
+            assets.musicData = nullptr;
+            assets.musicSize = 0;
+            assets.loadAtlas = false;
+            assets.loadMusic = false;
+        } else {
+            StopMusicStream(ThemeMusic(theme));
         }
+        ThemeMusic(theme) = Music{};
+        resourceManager.Release(assets.atlasHandle);
+        resourceManager.Release(assets.musicHandle);
+        assets.state = ThemeLoadState::Released;
     }
 
-    void LoadDesertResources() {
-        if (!desertResourcesLoaded) {
-            camelTexture = LoadTexture("Assets/camel.png");
-            oasisTexture = LoadTexture("Assets/oasis.png");
-            cactusTexture = LoadTexture("Assets/cactus.png");
-            tumbleweedTexture = LoadTexture("Assets/tumbleweed.png");
-            desertAmbient = LoadMusicStream("sounds/desert_ambient.wav");
-            
-            desertResourcesLoaded = true;
+    bool IsThemeReady(GameTheme theme) {
+        return Assets(theme).state == ThemeLoadState::Held;
+    }
+
+    void UpdateStreaming() {
+        streamer.Update();
+
+        // One atlas slice per frame within the upload budget, the theme on screen first
+        GameTheme uploading = GAME_STATE.getCurrentTheme();
+        if (Assets(uploading).state != ThemeLoadState::Uploading) {
+            if (!hasNextTheme || Assets(nextTheme).state != ThemeLoadState::Uploading) return;
+            uploading = nextTheme;
         }
+        ThemeAssets& assets = Assets(uploading);
+        if (assets.atlas.UploadRows(ASSET_UPLOAD_BUDGET_BYTES)) FinishTheme(uploading, assets);
     }
 
-    void UnloadDesertResources() {
-        if (desertResourcesLoaded) {
-            UnloadTexture(camelTexture);
-            UnloadTexture(oasisTexture);
-            UnloadTexture(cactusTexture);
-            UnloadTexture(tumbleweedTexture);
-            UnloadMusicStream(desertAmbient);
+    const SpriteAtlas& GetThemeAtlas() {
+        const ThemeAssets& assets = Assets(GAME_STATE.getCurrentTheme());
+        return assets.state == ThemeLoadState::Held ? assets.atlas : fallbackAtlas;
+    }
 
-            desertResourcesLoaded = false;
+    void LoadFallbackSprites() {
+        if (!fallbackSpritesLoaded) {
+            // Plain light shapes, tinted like the real sprites when drawn
+            Image player = GenImageColor(32, 32, BLANK);
+            ImageDrawCircle(&player, 16, 16, 14, WHITE);
+            fallbackAtlas.Add(SpriteId::Player, player);
+
+            Image goal = GenImageColor(64, 64, BLANK);
+            ImageDrawCircle(&goal, 32, 32, 30, SKYBLUE);
+            fallbackAtlas.Add(SpriteId::Goal, goal);
+
+            fallbackAtlas.Add(SpriteId::Obstacle, GenImageColor(32, 32, LIGHTGRAY));
+            Image obstacleAlt = GenImageColor(32, 32, BLANK);
+            ImageDrawCircle(&obstacleAlt, 16, 16, 14, LIGHTGRAY);
+            fallbackAtlas.Add(SpriteId::ObstacleAlt, obstacleAlt);
+
+            Image timeBonus = GenImageColor(32, 32, BLANK);
+            ImageDrawCircle(&timeBonus, 16, 16, 12, GOLD);
+            fallbackAtlas.Add(SpriteId::TimeBonus, timeBonus);
+            Image speedBoost = GenImageColor(32, 32, BLANK);
+            ImageDrawCircle(&speedBoost, 16, 16, 12, LIME);
+            fallbackAtlas.Add(SpriteId::SpeedBoost, speedBoost);
+
+            fallbackAtlas.Pack();
+            fallbackSpritesLoaded = true;
         }
     }
 
     void LoadPowerupResources() {
         if (!powerupResourcesLoaded) {
-            timeBonusTexture = LoadTexture("Assets/timeBonus.png");
-            speedBoostTexture = LoadTexture("Assets/speedBoost.png");
-
-            // Sound effects for powerups
-            bonusSound = LoadSound("sounds/bonus.wav");
+            // Sound effects for powerups (their sprites live in the theme atlas)
+            bonusSound = HoldSound("sounds/bonus.wav", bonusSoundHandle);
+            SetSfx(SfxId::Bonus, bonusSound);
 
             powerupResourcesLoaded = true;
         }
@@ -124,10 +398,9 @@ namespace GameResources {
     
     void UnloadPowerupResources() {
         if (powerupResourcesLoaded) {
-            UnloadTexture(timeBonusTexture);
-            UnloadTexture(speedBoostTexture);
-
-            UnloadSound(bonusSound);
+            // Aliases first; the cache may unload the sound once it is released
+            sfx.Clear(SfxId::Bonus);
+            resourceManager.Release(bonusSoundHandle);
 
             powerupResourcesLoaded = false;
         }
@@ -135,11 +408,16 @@ namespace GameResources {
 
     void LoadGeneralSounds() {
         if (!generalSoundsLoaded) {
-            startSound = LoadSound("sounds/poweron.wav");
-            blockedSound = LoadSound("sounds/blocked.wav");
-            winSound = LoadSound("sounds/win.wav");
-            loseSound = LoadSound("sounds/lose.wav");
-            menuSound = LoadSound("sounds/select.wav");
+            startSound = HoldSound("sounds/poweron.wav", generalSoundHandles[0]);
+            blockedSound = HoldSound("sounds/blocked.wav", generalSoundHandles[1]);
+            winSound = HoldSound("sounds/win.wav", generalSoundHandles[2]);
+            loseSound = HoldSound("sounds/lose.wav", generalSoundHandles[3]);
+            menuSound = HoldSound("sounds/select.wav", generalSoundHandles[4]);
+            SetSfx(SfxId::Start, startSound);
+            SetSfx(SfxId::Blocked, blockedSound);
+            SetSfx(SfxId::Win, winSound);
+            SetSfx(SfxId::Lose, loseSound);
+            SetSfx(SfxId::Menu, menuSound);
 
             generalSoundsLoaded = true;
         }
@@ -147,38 +425,35 @@ namespace GameResources {
 
     void UnloadGeneralSounds() {
         if (generalSoundsLoaded) {
-            UnloadSound(startSound);
-            UnloadSound(blockedSound);
-            UnloadSound(winSound);
-            UnloadSound(loseSound);
-            UnloadSound(menuSound);
+            for (SfxId id : { SfxId::Start, SfxId::Blocked, SfxId::Win, SfxId::Lose, SfxId::Menu }) sfx.Clear(id);
+            for (SoundHandle& handle : generalSoundHandles) resourceManager.Release(handle);
 
             generalSoundsLoaded = false;
         }
     }
-    void UnloadUnusedResources() {
-        // Unload resources for themes that are not currently active
-        switch (GAME_STATE.getCurrentTheme()) {
-            case GameTheme::Space:
-                UnloadJungleResources();
-                UnloadDesertResources();
-                break;
-            case GameTheme::Jungle:
-                UnloadSpaceResources();
-                UnloadDesertResources();
-                break;
-            case GameTheme::Desert:
-                UnloadSpaceResources();
-                UnloadJungleResources();
-                break;
+    void ReleaseUnusedThemes() {
+        // Themes neither on screen nor prefetched go back to the cache, which evicts them when over budget
+        for (int i = 0; i < THEME_COUNT; i++) {
+            const GameTheme theme = static_cast<GameTheme>(i);
+            if (!IsWanted(theme)) ReleaseTheme(theme);
         }
     }
     void UnloadAllResources() {
-        UnloadSpaceResources();
-        UnloadJungleResources();
-        UnloadDesertResources();
+        // Workers first; a job they never started decoded nothing, so only its cache references remain
+        streamer.Stop();
+        for (int i = 0; i < THEME_COUNT; i++) {
+            if (themes[i].state == ThemeLoadState::Decoding) themes[i].state = ThemeLoadState::Uploading;
+            ReleaseTheme(static_cast<GameTheme>(i));
+        }
+        if (fallbackSpritesLoaded) {
+            fallbackAtlas.Unload();
+            fallbackSpritesLoaded = false;
+        }
         UnloadPowerupResources();
         UnloadGeneralSounds();
+        resourceManager.Clear();
+        // Last: music streams read from the mapping until unloaded
+        archive.Close();
     }
 }
 
@@ -207,75 +482,46 @@ const ThemeColors DESERT_COLORS = {
     {0, 191, 255, 255}      // Blue oasis
 };
 
-GameTheme lastTheme = static_cast<GameTheme>(-1); // Initialize with an invalid theme
-
 void RandomizeTheme() {
-    GameTheme newTheme;
-    do {
-        newTheme = static_cast<GameTheme>(rand() % 3);
-    } while (newTheme == lastTheme);
+    const GameTheme newTheme = hasNextTheme ? nextTheme : RollTheme();
+    hasNextTheme = false;
 
     lastTheme = newTheme;
     GAME_STATE.setCurrentTheme(newTheme);
     SetThemeResources(newTheme);
 }
 
-Texture2D GetPlayerTextureForTheme(GameTheme theme) {
-    switch(theme) {
-        case GameTheme::Space:
-            return GameResources::spaceshipTexture;
-        case GameTheme::Jungle:
-            return GameResources::monkeyTexture;
-        case GameTheme::Desert:
-            return GameResources::camelTexture;
-        default:
-            return GameResources::spaceshipTexture;
+void PrefetchNextTheme() {
+    if (!hasNextTheme) {
+        nextTheme = RollTheme();
+        hasNextTheme = true;
     }
+    GameResources::RequestTheme(nextTheme);
 }
 
-Texture2D GetGoalTextureForTheme(GameTheme theme) {
-    switch(theme) {
-        case GameTheme::Space:
-            return GameResources::portalPlaceholder;
-        case GameTheme::Jungle:
-            return GameResources::bananaTexture;
-        case GameTheme::Desert:
-            return GameResources::oasisTexture;
-        default:
-            return GameResources::portalPlaceholder;
-    }
+void QueueSprite(SpriteId id, int frame, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    const SpriteAtlas& atlas = GameResources::GetThemeAtlas();
+    GameResources::spriteBatch.Draw(atlas.getTexture(), atlas.Frame(id, frame), dest, origin, rotation, tint);
+}
+
+void DrawSprite(SpriteId id, Rectangle dest, Vector2 origin, float rotation, Color tint, bool flipX) {
+    const SpriteAtlas& atlas = GameResources::GetThemeAtlas();
+    Rectangle source = atlas.Frame(id);
+    if (flipX) source.width = -source.width;
+    DrawTexturePro(atlas.getTexture(), source, dest, origin, rotation, tint);
 }
 
 void SetThemeResources(GameTheme theme) {
-    // Unload unused resources
-    GameResources::UnloadUnusedResources();
+    GAME_STATE.setCurrentTheme(theme);
 
-    // Load resources for the current theme
-    switch (theme) {
-        case GameTheme::Space:
-            GameResources::LoadSpaceResources();
-            GAME_STATE.setCurrentTheme(GameTheme::Space);
-            if (GAME_STATE.getSoundSettings() != SoundSettings::MusicOff && GAME_STATE.getSoundSettings() != SoundSettings::AllOff) {
-                PlayMusicStream(GameResources::spaceAmbient);
-                SetMusicVolume(GameResources::spaceAmbient, 1.0f);
-            }
-            break;
-        case GameTheme::Jungle:
-            GameResources::LoadJungleResources();
-            GAME_STATE.setCurrentTheme(GameTheme::Jungle);
-            if (GAME_STATE.getSoundSettings() != SoundSettings::MusicOff && GAME_STATE.getSoundSettings() != SoundSettings::AllOff) {
-                PlayMusicStream(GameResources::jungleAmbient);
-                SetMusicVolume(GameResources::jungleAmbient, 1.0f);
-            }
-            break;
-        case GameTheme::Desert:
-            GameResources::LoadDesertResources();
-            GAME_STATE.setCurrentTheme(GameTheme::Desert);
-            if (GAME_STATE.getSoundSettings() != SoundSettings::MusicOff && GAME_STATE.getSoundSettings() != SoundSettings::AllOff) {
-                PlayMusicStream(GameResources::desertAmbient);
-                SetMusicVolume(GameResources::desertAmbient, 1.0f);
-            }
-            break;
+    GameResources::ReleaseUnusedThemes();
+
+    // Already held (e.g. resuming from pause), or cached or streamed in; the
+    // fallback sprites are drawn and the music starts once the theme is held
+    if (GameResources::IsThemeReady(theme)) {
+        PlayThemeMusic(theme);
+    } else {
+        GameResources::RequestTheme(theme);
     }
 }
 
@@ -292,18 +538,3 @@ void StopCurrentThemeMusic() {
             break;
     }
 }
-
-Texture2D CreateStarFieldTexture(int width, int height, int starCount) {
-    Image starField = GenImageColor(width, height, BLANK);  // Create blank image
-
-    for (int i = 0; i < starCount; i++) {
-        int x = GetRandomValue(0, width - 1);  // Random x-coordinate
-        int y = GetRandomValue(0, height - 1); // Random y-coordinate
-        Color starColor = ColorAlpha(WHITE, GetRandomValue(50, 100) / 100.0f);  // Semi-transparent stars
-        ImageDrawPixel(&starField, x, y, starColor);  // Draw star pixel
-    }
-
-    Texture2D starFieldTexture = LoadTextureFromImage(starField);  // Convert to texture
-    UnloadImage(starField);  // Free image memory
-    return starFieldTexture;
-}
\ No newline at end of file
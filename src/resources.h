@@ -2,6 +2,12 @@
 #define RESOURCES_H
 
 #include "raylib.h"
+#include "maze_types.h"
+#include "sprite_atlas.h"
+#include "sprite_batch.h"
+#include "particle_system.h"
+#include "resource_manager.h"
+#include "sfx_pool.h"
 
 // Theme-specific colors
 struct ThemeColors {
@@ -28,14 +34,8 @@ enum GameStates {
 // Game modes
 enum GameMode {
     Timed,
-    Untimed
-};
-
-// Difficulty levels
-enum Difficulty {
-    Easy,
-    Medium,
-    Hard
+    Untimed,
+    Endless
 };
 
 // Menu states
@@ -52,29 +52,30 @@ enum class SoundSettings {
     AllOff
 };
 
+// Frame grids of the obstacle spritesheets
+const int ASTEROID_SPRITE_COLUMNS = 16;
+const int ASTEROID_SPRITE_ROWS = 2;
+const int LOG_SPRITE_COLUMNS = 3;
+const int LOG_SPRITE_ROWS = 3;
+
 namespace GameResources {
-    // Space theme textures and music
-    extern Texture2D spaceshipTexture;
-    extern Texture2D portalPlaceholder;
-    extern Texture2D asteroidSpritesheet;
+    // Stand-in shapes drawn while the current theme's atlas is still streaming
+    extern SpriteAtlas fallbackAtlas;
+    // Per-cell sprite draws queue here and are flushed once per atlas
+    extern SpriteBatch spriteBatch;
+    // Portal sparks and the theme's ambient particles share one pool
+    extern ParticleSystem particles;
+    // Theme atlases, music and sound effects, kept after release while within budget
+    extern ResourceManager resourceManager;
+    // Sound effects play through here rather than PlaySound(), so repeats are
+    // rate-limited and overlap within a fixed voice budget
+    extern SfxPool sfx;
+
+    // Theme music
     extern Music spaceAmbient;
-
-    // Jungle theme textures and music
-    extern Texture2D monkeyTexture;
-    extern Texture2D bananaTexture;
-    extern Texture2D logsSpritesheet;
     extern Music jungleAmbient;
-
-    // Desert theme textures and music
-    extern Texture2D camelTexture;
-    extern Texture2D oasisTexture;
-    extern Texture2D cactusTexture;
-    extern Texture2D tumbleweedTexture;
     extern Music desertAmbient;
 
-    extern Texture2D timeBonusTexture;
-    extern Texture2D speedBoostTexture;
-
     extern Sound startSound;
     extern Sound blockedSound;
     extern Sound winSound;
@@ -83,17 +84,26 @@ namespace GameResources {
     extern Sound portalSound;
     extern Sound bonusSound;
 
-    void LoadSpaceResources();
-    void UnloadSpaceResources();
-    void LoadJungleResources();
-    void UnloadJungleResources();
-    void LoadDesertResources();
-    void UnloadDesertResources();
+    // Maps the packed archive built by tools/pakbuild; assets it lacks, or all
+    // of them when it cannot be opened, are loaded from the loose files
+    bool OpenAssetArchive(const char* fileName);
+    // Theme sprites (plus the powerups) and music are taken from the resource
+    // cache, or decoded on worker threads when it no longer holds them;
+    // RequestTheme() returns at once and UpdateStreaming() finishes the job on
+    // the main thread, uploading the atlas a slice per frame. ReleaseTheme()
+    // hands the theme back to the cache.
+    void RequestTheme(GameTheme theme);
+    void ReleaseTheme(GameTheme theme);
+    bool IsThemeReady(GameTheme theme);
+    void UpdateStreaming();
+    // Sprites of the current theme, or the fallback shapes until they are uploaded
+    const SpriteAtlas& GetThemeAtlas();
+    void LoadFallbackSprites();
     void LoadPowerupResources();
     void UnloadPowerupResources();
     void LoadGeneralSounds();
     void UnloadGeneralSounds();
-    void UnloadUnusedResources();
+    void ReleaseUnusedThemes();
     void UnloadAllResources();
 }
 
@@ -102,10 +112,11 @@ extern const ThemeColors JUNGLE_COLORS;
 extern const ThemeColors DESERT_COLORS;
 
 void RandomizeTheme();
-Texture2D GetPlayerTextureForTheme(GameTheme theme);
-Texture2D GetGoalTextureForTheme(GameTheme theme);
+// Rolls the theme RandomizeTheme() will pick next and starts streaming it
+void PrefetchNextTheme();
+void QueueSprite(SpriteId id, int frame, Rectangle dest, Vector2 origin, float rotation, Color tint);
+void DrawSprite(SpriteId id, Rectangle dest, Vector2 origin, float rotation, Color tint, bool flipX = false);
 void SetThemeResources(GameTheme theme);
 void StopCurrentThemeMusic();
-Texture2D CreateStarFieldTexture(int width, int height, int starCount);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "rng.h"
+
+void Xoshiro256::Seed(uint64_t seed) {
+    for (uint64_t& word : m_s) {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        word = z ^ (z >> 31);
+    }
+}
+
+void Xoshiro256::ApplyJump(const uint64_t (&table)[4]) {
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (uint64_t bits : table) {
+        for (int b = 0; b < 64; b++) {
+            if (bits & (uint64_t(1) << b)) {
+                s0 ^= m_s[0];
+                s1 ^= m_s[1];
+                s2 ^= m_s[2];
+                s3 ^= m_s[3];
+            }
+            operator()();
+        }
+    }
+    m_s[0] = s0;
+    m_s[1] = s1;
+    m_s[2] = s2;
+    m_s[3] = s3;
+}
+
+void Xoshiro256::Jump() {
+    static const uint64_t JUMP[4] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                     0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    ApplyJump(JUMP);
+}
+
+void Xoshiro256::LongJump() {
+    static const uint64_t LONG_JUMP[4] = {0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull,
+                                          0x77710069854EE241ull, 0x39109BB02ACBE635ull};
+    ApplyJump(LONG_JUMP);
+}
+
+void RandomService::SeedSession(uint64_t seed) {
+    SeedRange(seed, RngStream::Session, RngStream::Count);
+}
+
+void RandomService::BeginMaze(uint64_t mazeSeed) {
+    SeedRange(mazeSeed, RngStream::Maze, RngStream::Count);
+}
+
+void RandomService::SeedRange(uint64_t seed, RngStream first, RngStream last) {
+    // One base stream, long-jumped apart for each consumer
+    Xoshiro256 base(seed);
+    for (int i = static_cast<int>(first); i < static_cast<int>(last); i++) {
+        m_streams[i] = base;
+        base.LongJump();
+    }
+}
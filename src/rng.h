@@ -0,0 +1,94 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// xoshiro256** (Blackman & Vigna): 4 words of state, a handful of ALU ops per
+// draw. Satisfies UniformRandomBitGenerator, so std::shuffle and the <random>
+// distributions accept it directly.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { Seed(seed); }
+
+    // Expands a 64-bit seed into the full state with SplitMix64
+    void Seed(uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        const uint64_t result = Rotl(m_s[1] * 5, 7) * 9;
+        const uint64_t t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = Rotl(m_s[3], 45);
+        return result;
+    }
+
+    // Equivalent to 2^128 draws; used to hand out per-thread / per-tile substreams
+    void Jump();
+    // Equivalent to 2^192 draws; used to separate subsystem streams
+    void LongJump();
+
+    // Returns a copy of this stream and jumps past it, so the two never overlap
+    Xoshiro256 Split() {
+        Xoshiro256 child = *this;
+        Jump();
+        return child;
+    }
+
+    // Uniform in [0, bound) by multiply-shift (bias below 2^-32 for game-sized bounds)
+    int NextInt(int bound) {
+        return static_cast<int>(((operator()() >> 32) * static_cast<uint64_t>(bound)) >> 32);
+    }
+    // Uniform in [min, max], both inclusive
+    int NextRange(int minValue, int maxValue) { return minValue + NextInt(maxValue - minValue + 1); }
+    // Uniform in [0, 1)
+    float NextFloat() { return static_cast<float>(operator()() >> 40) * (1.0f / 16777216.0f); }
+
+private:
+    static uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    void ApplyJump(const uint64_t (&table)[4]);
+
+    uint64_t m_s[4];
+};
+
+// Independent random streams, one per consumer.
+// Session streams are seeded once per run. Maze streams are re-derived from the
+// maze seed, so the same seed reproduces the same layout, exit, obstacles and
+// powerups regardless of thread count or what the effects drew in between.
+enum class RngStream {
+    Session,    // Draws the per-maze seeds
+    Theme,
+    Effects,
+    Maze,       // First maze stream: generation and sprite variants
+    Exit,
+    Obstacles,
+    Powerups,
+    Endless,
+    Count
+};
+
+class RandomService {
+public:
+    explicit RandomService(uint64_t sessionSeed = 0) { SeedSession(sessionSeed); }
+
+    // Reseeds every stream (maze streams included)
+    void SeedSession(uint64_t seed);
+    // Re-derives only the maze streams from a per-maze seed
+    void BeginMaze(uint64_t mazeSeed);
+
+    Xoshiro256& Stream(RngStream stream) { return m_streams[static_cast<int>(stream)]; }
+
+private:
+    void SeedRange(uint64_t seed, RngStream first, RngStream last);
+
+    Xoshiro256 m_streams[static_cast<int>(RngStream::Count)];
+};
+
+#endif
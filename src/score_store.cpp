@@ -0,0 +1,247 @@
+#include "score_store.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <queue>
+
+namespace {
+    const long SCORE_RECORDS_OFFSET = static_cast<long>(sizeof(ScoreLogHeader));
+    // Records read per fread while streaming the log
+    const int SCORE_SCAN_CHUNK = 256;
+
+    uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0) {
+        static uint32_t table[256];
+        static bool tableReady = false;
+        if (!tableReady) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++) value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                table[i] = value;
+            }
+            tableReady = true;
+        }
+
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    uint32_t RecordChecksum(const ScoreRecord& record) {
+        return Crc32(&record, offsetof(ScoreRecord, checksum));
+    }
+
+    // Fastest first; equal times keep the order they were set in
+    bool Faster(uint32_t timeMs, uint32_t record, uint32_t otherTimeMs, uint32_t otherRecord) {
+        return timeMs != otherTimeMs ? timeMs < otherTimeMs : record < otherRecord;
+    }
+}
+
+bool ScoreStore::Open(const char* logFile, const char* indexFile) {
+    Close();
+    m_indexFile = indexFile;
+
+    ScoreLogHeader header = {};
+    m_log = std::fopen(logFile, "r+b");
+    if (m_log == nullptr) {
+        m_log = std::fopen(logFile, "w+b");
+        if (m_log == nullptr) return false;
+        std::memcpy(header.magic, SCORE_LOG_MAGIC, sizeof(header.magic));
+        header.version = SCORE_LOG_VERSION;
+        header.recordSize = sizeof(ScoreRecord);
+        if (std::fwrite(&header, sizeof(header), 1, m_log) != 1 || std::fflush(m_log) != 0) {
+            Close();
+            return false;
+        }
+    } else if (std::fread(&header, sizeof(header), 1, m_log) != 1 ||
+               std::memcmp(header.magic, SCORE_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+               header.version != SCORE_LOG_VERSION || header.recordSize != sizeof(ScoreRecord)) {
+        Close();
+        return false;
+    }
+
+    // Whole records only; a torn one at the end is overwritten by the next Append()
+    std::fseek(m_log, 0, SEEK_END);
+    const long size = std::ftell(m_log);
+    m_records = size > SCORE_RECORDS_OFFSET ? static_cast<uint32_t>((size - SCORE_RECORDS_OFFSET) / sizeof(ScoreRecord)) : 0;
+
+    // Trust the saved index only for the log it was built from
+    uint32_t covered = 0;
+    uint32_t lastChecksum = 0;
+    ScoreRecord last;
+    const bool indexMatches = LoadIndex(covered, lastChecksum) && covered <= m_records &&
+                              (covered == 0 || (ReadRecord(covered - 1, last) && last.checksum == lastChecksum));
+    if (!indexMatches) {
+        std::memset(m_buckets, 0, sizeof(m_buckets));
+        covered = 0;
+        lastChecksum = 0;
+    }
+    m_lastChecksum = lastChecksum;
+    if (!indexMatches || covered < m_records) {
+        IndexRecords(covered);
+        SaveIndex();
+    }
+    return true;
+}
+
+void ScoreStore::Close() {
+    if (m_log != nullptr) std::fclose(m_log);
+    m_log = nullptr;
+    m_records = 0;
+    m_lastChecksum = 0;
+    m_corruptRecords = 0;
+    std::memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+long long ScoreStore::Append(ScoreRecord record) {
+    if (m_log == nullptr || record.difficulty >= SCORE_DIFFICULTIES || record.mode >= SCORE_MODES) return -1;
+
+    record.reserved = 0;
+    record.sequence = m_records;
+    record.checksum = RecordChecksum(record);
+    const long offset = SCORE_RECORDS_OFFSET + static_cast<long>(m_records) * static_cast<long>(sizeof(ScoreRecord));
+    if (std::fseek(m_log, offset, SEEK_SET) != 0 || std::fwrite(&record, sizeof(record), 1, m_log) != 1 ||
+        std::fflush(m_log) != 0) {
+        return -1;
+    }
+
+    // The log is written first, so a crash before the index is saved only leaves it behind
+    m_records++;
+    m_lastChecksum = record.checksum;
+    IndexRecord(record);
+    SaveIndex();
+    return record.sequence;
+}
+
+std::vector<ScoreRecord> ScoreStore::Top(int difficulty, int mode, int k) const {
+    std::vector<ScoreRecord> top;
+    if (m_log == nullptr || k <= 0 || difficulty < 0 || difficulty >= SCORE_DIFFICULTIES || mode < 0 || mode >= SCORE_MODES) {
+        return top;
+    }
+
+    // A bucket that never filled its index holds every record of the bucket
+    const ScoreIndexBucket& bucket = m_buckets[Bucket(difficulty, mode)];
+    if (k <= SCORE_INDEX_DEPTH || bucket.count < static_cast<uint32_t>(SCORE_INDEX_DEPTH)) {
+        const uint32_t count = std::min(bucket.count, static_cast<uint32_t>(k));
+        for (uint32_t i = 0; i < count; i++) {
+            ScoreRecord record;
+            if (ReadRecord(bucket.entries[i].record, record) && IsValid(record, bucket.entries[i].record)) {
+                top.push_back(record);
+            }
+        }
+        return top;
+    }
+
+    // Deeper than the index: stream the log, keeping the best k seen so far with the slowest on top
+    auto slower = [](const ScoreRecord& a, const ScoreRecord& b) {
+        return Faster(a.timeMs, a.sequence, b.timeMs, b.sequence);
+    };
+    std::priority_queue<ScoreRecord, std::vector<ScoreRecord>, decltype(slower)> best(slower);
+    ScoreRecord chunk[SCORE_SCAN_CHUNK];
+    std::fseek(m_log, SCORE_RECORDS_OFFSET, SEEK_SET);
+    for (uint32_t first = 0; first < m_records; first += SCORE_SCAN_CHUNK) {
+        const size_t wanted = std::min(static_cast<uint32_t>(SCORE_SCAN_CHUNK), m_records - first);
+        const size_t read = std::fread(chunk, sizeof(ScoreRecord), wanted, m_log);
+        for (size_t i = 0; i < read; i++) {
+            const ScoreRecord& record = chunk[i];
+            if (!IsValid(record, first + static_cast<uint32_t>(i)) || record.difficulty != difficulty || record.mode != mode) continue;
+            if (static_cast<int>(best.size()) < k) {
+                best.push(record);
+            } else if (Faster(record.timeMs, record.sequence, best.top().timeMs, best.top().sequence)) {
+                best.pop();
+                best.push(record);
+            }
+        }
+        if (read < wanted) break;
+    }
+    for (; !best.empty(); best.pop()) top.push_back(best.top());
+    std::reverse(top.begin(), top.end());
+    return top;
+}
+
+bool ScoreStore::IsValid(const ScoreRecord& record, uint32_t number) {
+    return record.checksum == RecordChecksum(record) && record.sequence == number &&
+           record.difficulty < SCORE_DIFFICULTIES && record.mode < SCORE_MODES;
+}
+
+bool ScoreStore::ReadRecord(uint32_t number, ScoreRecord& record) const {
+    if (number >= m_records) return false;
+    const long offset = SCORE_RECORDS_OFFSET + static_cast<long>(number) * static_cast<long>(sizeof(ScoreRecord));
+    return std::fseek(m_log, offset, SEEK_SET) == 0 && std::fread(&record, sizeof(record), 1, m_log) == 1;
+}
+
+void ScoreStore::IndexRecords(uint32_t first) {
+    ScoreRecord chunk[SCORE_SCAN_CHUNK];
+    std::fseek(m_log, SCORE_RECORDS_OFFSET + static_cast<long>(first) * static_cast<long>(sizeof(ScoreRecord)), SEEK_SET);
+    for (uint32_t number = first; number < m_records;) {
+        const size_t wanted = std::min(static_cast<uint32_t>(SCORE_SCAN_CHUNK), m_records - number);
+        const size_t read = std::fread(chunk, sizeof(ScoreRecord), wanted, m_log);
+        for (size_t i = 0; i < read; i++, number++) {
+            m_lastChecksum = chunk[i].checksum;
+            if (IsValid(chunk[i], number)) {
+                IndexRecord(chunk[i]);
+            } else {
+                m_corruptRecords++;
+            }
+        }
+        if (read < wanted) {
+            // Shorter than it measured on open; only what was read is covered
+            m_records = number;
+            break;
+        }
+    }
+}
+
+void ScoreStore::IndexRecord(const ScoreRecord& record) {
+    ScoreIndexBucket& bucket = m_buckets[Bucket(record.difficulty, record.mode)];
+    ScoreIndexEntry* end = bucket.entries + bucket.count;
+    ScoreIndexEntry* position = std::upper_bound(bucket.entries, end, record, [](const ScoreRecord& value, const ScoreIndexEntry& entry) {
+        return Faster(value.timeMs, value.sequence, entry.timeMs, entry.record);
+    });
+    if (position == bucket.entries + SCORE_INDEX_DEPTH) return;
+
+    // Shift slower entries down, dropping the slowest once the bucket is full
+    if (bucket.count < static_cast<uint32_t>(SCORE_INDEX_DEPTH)) {
+        bucket.count++;
+        end++;
+    }
+    std::move_backward(position, end - 1, end);
+    *position = ScoreIndexEntry{ record.timeMs, record.sequence };
+}
+
+bool ScoreStore::LoadIndex(uint32_t& records, uint32_t& lastChecksum) {
+    FILE* file = std::fopen(m_indexFile.c_str(), "rb");
+    if (file == nullptr) return false;
+
+    ScoreIndexHeader header = {};
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::fread(m_buckets, sizeof(m_buckets), 1, file) == 1;
+    std::fclose(file);
+
+    ok = ok && std::memcmp(header.magic, SCORE_INDEX_MAGIC, sizeof(header.magic)) == 0 &&
+         header.version == SCORE_INDEX_VERSION && header.depth == static_cast<uint32_t>(SCORE_INDEX_DEPTH) &&
+         header.checksum == Crc32(m_buckets, sizeof(m_buckets));
+    for (const ScoreIndexBucket& bucket : m_buckets) {
+        ok = ok && bucket.count <= static_cast<uint32_t>(SCORE_INDEX_DEPTH);
+    }
+    records = header.records;
+    lastChecksum = header.lastChecksum;
+    return ok;
+}
+
+void ScoreStore::SaveIndex() const {
+    // Small and fixed-size, so it is simply rewritten; a torn write fails its checksum and is rebuilt
+    FILE* file = std::fopen(m_indexFile.c_str(), "wb");
+    if (file == nullptr) return;
+
+    ScoreIndexHeader header = {};
+    std::memcpy(header.magic, SCORE_INDEX_MAGIC, sizeof(header.magic));
+    header.version = SCORE_INDEX_VERSION;
+    header.depth = SCORE_INDEX_DEPTH;
+    header.records = m_records;
+    header.lastChecksum = m_lastChecksum;
+    header.checksum = Crc32(m_buckets, sizeof(m_buckets));
+    std::fwrite(&header, sizeof(header), 1, file);
+    std::fwrite(m_buckets, sizeof(m_buckets), 1, file);
+    std::fclose(file);
+}
@@ -0,0 +1,116 @@
+#ifndef SCORE_STORE_H
+#define SCORE_STORE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Append-only score log ("scores.log") with an index of the best scores per
+// (difficulty, mode) bucket ("scores.idx"). The log is a header followed by
+// fixed-size records, each with its own CRC-32, and is never rewritten: new
+// scores go on the end and a torn last record is overwritten by the next one.
+// The index only holds record numbers and times, so a top-k query reads k
+// records however long the history is. It is derived data: when it is missing,
+// damaged or behind the log it is rebuilt or caught up by streaming the log.
+// Everything is little-endian.
+//
+// Raylib-free; ui.cpp maps its Difficulty and GameMode values onto buckets.
+
+const char SCORE_LOG_MAGIC[4] = { 'P', 'P', 'S', 'L' };
+const char SCORE_INDEX_MAGIC[4] = { 'P', 'P', 'S', 'I' };
+const uint32_t SCORE_LOG_VERSION = 1;
+const uint32_t SCORE_INDEX_VERSION = 1;
+const char SCORE_LOG_FILE[] = "scores.log";
+const char SCORE_INDEX_FILE[] = "scores.idx";
+
+const int SCORE_DIFFICULTIES = 3;
+const int SCORE_MODES = 3;
+const int SCORE_BUCKETS = SCORE_DIFFICULTIES * SCORE_MODES;
+// Best scores the index keeps per bucket; deeper queries scan the log
+const int SCORE_INDEX_DEPTH = 64;
+
+struct ScoreLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+struct ScoreRecord {
+    int64_t timestamp;                  // Seconds since the epoch, UTC
+    uint32_t timeMs;                    // Completion time; lower is better
+    uint8_t difficulty;
+    uint8_t mode;
+    uint16_t reserved;
+    uint32_t sequence;                  // Record number, so a record found out of place fails its check
+    uint32_t checksum;                  // CRC-32 of the bytes above
+};
+
+struct ScoreIndexEntry {
+    uint32_t timeMs;
+    uint32_t record;
+};
+
+struct ScoreIndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t depth;                     // SCORE_INDEX_DEPTH it was written with
+    uint32_t records;                   // Log records it covers
+    uint32_t lastChecksum;              // Checksum of the last covered record, to tell the log was not replaced
+    uint32_t checksum;                  // CRC-32 of the bucket data that follows
+};
+
+struct ScoreIndexBucket {
+    uint32_t count;
+    ScoreIndexEntry entries[SCORE_INDEX_DEPTH];     // Fastest first, ties in record order
+};
+
+static_assert(sizeof(ScoreLogHeader) == 16, "score log header layout");
+static_assert(sizeof(ScoreRecord) == 24, "score record layout");
+static_assert(sizeof(ScoreIndexHeader) == 24, "score index header layout");
+static_assert(sizeof(ScoreIndexBucket) == 4 + SCORE_INDEX_DEPTH * 8, "score index bucket layout");
+
+class ScoreStore {
+public:
+    ScoreStore() = default;
+    ScoreStore(const ScoreStore&) = delete;
+    ScoreStore& operator=(const ScoreStore&) = delete;
+    ~ScoreStore() { Close(); }
+
+    // Creates the log when missing; fails on a log of another format
+    bool Open(const char* logFile = SCORE_LOG_FILE, const char* indexFile = SCORE_INDEX_FILE);
+    void Close();
+    bool IsOpen() const { return m_log != nullptr; }
+
+    // Fills in sequence and checksum; returns the record number, or -1
+    long long Append(ScoreRecord record);
+    // Best k of a bucket, fastest first. Reads only the indexed records
+    // unless k is deeper than the index.
+    std::vector<ScoreRecord> Top(int difficulty, int mode, int k) const;
+
+    long long getRecordCount() const { return m_records; }
+    // Records the index skipped for a bad checksum, number or bucket since Open()
+    long long getCorruptRecords() const { return m_corruptRecords; }
+
+private:
+    static int Bucket(int difficulty, int mode) { return difficulty * SCORE_MODES + mode; }
+    // A record read back is only used when its checksum, number and bucket check out
+    static bool IsValid(const ScoreRecord& record, uint32_t number);
+    bool ReadRecord(uint32_t number, ScoreRecord& record) const;
+    // Streams records [first, m_records) into the index
+    void IndexRecords(uint32_t first);
+    void IndexRecord(const ScoreRecord& record);
+    // Fills the buckets and reports which log records they cover
+    bool LoadIndex(uint32_t& records, uint32_t& lastChecksum);
+    void SaveIndex() const;
+
+    FILE* m_log = nullptr;
+    std::string m_indexFile;
+    uint32_t m_records = 0;
+    uint32_t m_lastChecksum = 0;
+    long long m_corruptRecords = 0;
+    ScoreIndexBucket m_buckets[SCORE_BUCKETS] = {};
+};
+
+#endif
@@ -0,0 +1,113 @@
+#include "sfx_pool.h"
+
+void SfxPool::Set(SfxId id, Sound sound, const SfxSettings& settings) {
+    Clear(id);
+    Effect& effect = m_effects[Index(id)];
+    effect.settings = settings;
+    effect.lastPlayed = -1e9;
+    if (sound.frameCount == 0) return;
+
+    for (int i = 0; i < settings.voices; i++) {
+        Voice voice;
+        voice.alias = LoadSoundAlias(sound);
+        SetSoundVolume(voice.alias, m_volume);
+        effect.voices.push_back(voice);
+    }
+}
+
+void SfxPool::Clear(SfxId id) {
+    for (Voice& voice : m_effects[Index(id)].voices) {
+        StopSound(voice.alias);
+        UnloadSoundAlias(voice.alias);
+    }
+    m_effects[Index(id)].voices.clear();
+}
+
+void SfxPool::Clear() {
+    for (int i = 0; i < static_cast<int>(SfxId::Count); i++) Clear(static_cast<SfxId>(i));
+}
+
+bool SfxPool::Play(SfxId id) {
+    Effect& effect = m_effects[Index(id)];
+    // Muted effects cost the mixer nothing, so don't start them at all
+    if (effect.voices.empty() || m_volume <= 0.0f) return false;
+
+    const double now = GetTime();
+    if (now - effect.lastPlayed < effect.settings.cooldown) {
+        m_stats.throttled++;
+        m_stats.dropped++;
+        return false;
+    }
+
+    // A free alias of this effect, or else its oldest one, restarted in place
+    Voice* voice = nullptr;
+    Voice* oldest = nullptr;
+    for (Voice& candidate : effect.voices) {
+        if (!IsSoundPlaying(candidate.alias)) {
+            voice = &candidate;
+            break;
+        }
+        if (oldest == nullptr || candidate.startedAt < oldest->startedAt) oldest = &candidate;
+    }
+
+    if (voice == nullptr) {
+        voice = oldest;
+        StopSound(voice->alias);
+        m_stats.stolen++;
+    } else if (getActiveVoices() >= m_maxVoices) {
+        // Starting a free alias adds a voice, so another one has to go
+        Voice* victim = FindVictim(effect.settings.priority);
+        if (victim == nullptr) {
+            m_stats.dropped++;
+            return false;
+        }
+        StopSound(victim->alias);
+        m_stats.stolen++;
+    }
+
+    PlaySound(voice->alias);
+    voice->startedAt = now;
+    effect.lastPlayed = now;
+    m_stats.played++;
+    return true;
+}
+
+void SfxPool::StopAll() {
+    for (Effect& effect : m_effects) {
+        for (Voice& voice : effect.voices) StopSound(voice.alias);
+    }
+}
+
+void SfxPool::SetVolume(float volume) {
+    m_volume = volume;
+    for (Effect& effect : m_effects) {
+        for (Voice& voice : effect.voices) SetSoundVolume(voice.alias, volume);
+    }
+}
+
+int SfxPool::getActiveVoices() const {
+    int active = 0;
+    for (const Effect& effect : m_effects) {
+        for (const Voice& voice : effect.voices) {
+            if (IsSoundPlaying(voice.alias)) active++;
+        }
+    }
+    return active;
+}
+
+SfxPool::Voice* SfxPool::FindVictim(SfxPriority priority) {
+    Voice* victim = nullptr;
+    SfxPriority victimPriority = priority;
+    for (Effect& effect : m_effects) {
+        if (effect.settings.priority > priority) continue;
+        for (Voice& voice : effect.voices) {
+            if (!IsSoundPlaying(voice.alias)) continue;
+            if (victim == nullptr || effect.settings.priority < victimPriority ||
+                (effect.settings.priority == victimPriority && voice.startedAt < victim->startedAt)) {
+                victim = &voice;
+                victimPriority = effect.settings.priority;
+            }
+        }
+    }
+    return victim;
+}
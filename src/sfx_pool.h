@@ -0,0 +1,87 @@
+#ifndef SFX_POOL_H
+#define SFX_POOL_H
+
+#include <vector>
+#include "raylib.h"
+
+// Sound effects the game plays through the pool
+enum class SfxId {
+    Start,
+    Blocked,
+    Win,
+    Lose,
+    Menu,
+    Bonus,
+    Count
+};
+
+// Higher priorities may stop lower ones when every voice is busy
+enum class SfxPriority {
+    Low,
+    Normal,
+    High
+};
+
+struct SfxSettings {
+    int voices = 1;                 // Aliases of the sound, i.e. copies that can overlap
+    float cooldown = 0.0f;          // Seconds before the effect may start again
+    SfxPriority priority = SfxPriority::Normal;
+};
+
+// Voices playing at once across every effect
+const int SFX_MAX_VOICES = 6;
+
+struct SfxStats {
+    long long played = 0;
+    long long dropped = 0;          // Requests that made no sound, throttled ones included
+    long long throttled = 0;        // Requests inside the effect's cooldown
+    long long stolen = 0;           // Voices stopped early to make room
+};
+
+// Mixes sound effects through a fixed set of voices. Each effect gets its own
+// sound aliases, which share the loaded samples but play independently, so
+// repeats overlap instead of restarting one voice. Requests inside an
+// effect's cooldown are dropped, and once SFX_MAX_VOICES are playing a new
+// voice only starts by stopping the oldest one of no higher priority.
+class SfxPool {
+public:
+    // The pool aliases the sound but never unloads it; Clear() the effect
+    // before the sound itself is unloaded
+    void Set(SfxId id, Sound sound, const SfxSettings& settings);
+    void Clear(SfxId id);
+    void Clear();
+
+    // Returns whether a voice was started
+    bool Play(SfxId id);
+    void StopAll();
+    // Applies to every voice, playing or not; at 0 requests are ignored
+    void SetVolume(float volume);
+    void SetMaxVoices(int maxVoices) { m_maxVoices = maxVoices; }
+
+    int getMaxVoices() const { return m_maxVoices; }
+    int getActiveVoices() const;
+    const SfxStats& getStats() const { return m_stats; }
+
+private:
+    struct Voice {
+        Sound alias = {0};
+        double startedAt = 0.0;
+    };
+
+    struct Effect {
+        std::vector<Voice> voices;
+        SfxSettings settings;
+        double lastPlayed = -1e9;
+    };
+
+    static int Index(SfxId id) { return static_cast<int>(id); }
+    // Oldest playing voice of the lowest priority, if it is not above priority
+    Voice* FindVictim(SfxPriority priority);
+
+    Effect m_effects[static_cast<int>(SfxId::Count)];
+    int m_maxVoices = SFX_MAX_VOICES;
+    float m_volume = 1.0f;
+    SfxStats m_stats;
+};
+
+#endif
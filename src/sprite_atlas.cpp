@@ -0,0 +1,151 @@
+#include "sprite_atlas.h"
+#include <algorithm>
+#include <cstring>
+#include "rlgl.h"
+
+void SpriteAtlas::Add(SpriteId id, const char* fileName, int columns, int rows) {
+    Add(id, LoadImage(fileName), columns, rows);
+}
+
+void SpriteAtlas::Add(SpriteId id, Image image, int columns, int rows, bool owned) {
+    Slot& slot = m_slots[Index(id)];
+    if (slot.image.data != nullptr && slot.owned) UnloadImage(slot.image);
+    slot.image = image;
+    slot.owned = owned;
+    slot.columns = std::max(columns, 1);
+    slot.rows = std::max(rows, 1);
+}
+
+void SpriteAtlas::Pack() {
+    PackImage();
+    UploadRows(m_pixels.width * m_pixels.height * 4);
+}
+
+void SpriteAtlas::PackImage() {
+    if (m_texture.id != 0) UnloadTexture(m_texture);
+    if (m_pixels.data != nullptr) UnloadImage(m_pixels);
+    m_texture = Texture2D{0};
+    m_pixels = Image{0};
+    m_uploadedRows = 0;
+    m_frames.clear();
+
+    // Tallest first keeps the shelves tight
+    std::vector<int> order;
+    int area = 0;
+    int widest = 0;
+    for (int i = 0; i < static_cast<int>(SpriteId::Count); i++) {
+        const Image& image = m_slots[i].image;
+        if (image.data == nullptr) continue;
+        order.push_back(i);
+        area += (image.width + ATLAS_PADDING) * (image.height + ATLAS_PADDING);
+        widest = std::max(widest, image.width + ATLAS_PADDING * 2);
+    }
+    if (order.empty()) return;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_slots[a].image.height > m_slots[b].image.height;
+    });
+
+    // Power-of-two width near the square root of the total area
+    int atlasWidth = 64;
+    while (atlasWidth * atlasWidth < area || atlasWidth < widest) atlasWidth *= 2;
+
+    // Place sprites left to right on shelves as tall as their first sprite
+    std::vector<Rectangle> placed(static_cast<int>(SpriteId::Count));
+    int penX = ATLAS_PADDING;
+    int penY = ATLAS_PADDING;
+    int shelfHeight = 0;
+    for (int i : order) {
+        const Image& image = m_slots[i].image;
+        if (penX + image.width + ATLAS_PADDING > atlasWidth) {
+            penX = ATLAS_PADDING;
+            penY += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        placed[i] = Rectangle{ (float)penX, (float)penY, (float)image.width, (float)image.height };
+        penX += image.width + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, image.height);
+    }
+    int atlasHeight = penY + shelfHeight + ATLAS_PADDING;
+
+    // Copy rows straight in; blending onto the blank atlas is not needed
+    Image atlas = GenImageColor(atlasWidth, atlasHeight, BLANK);
+    unsigned char* pixels = static_cast<unsigned char*>(atlas.data);
+    for (int i : order) {
+        Image& image = m_slots[i].image;
+        // A no-op for borrowed images, which are RGBA8 already
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        const unsigned char* source = static_cast<const unsigned char*>(image.data);
+        for (int row = 0; row < image.height; row++) {
+            std::memcpy(pixels + ((static_cast<int>(placed[i].y) + row) * atlasWidth + static_cast<int>(placed[i].x)) * 4,
+                        source + row * image.width * 4, image.width * 4);
+        }
+    }
+    m_pixels = atlas;
+
+    // Precompute every frame's source rectangle
+    for (int i = 0; i < static_cast<int>(SpriteId::Count); i++) {
+        Slot& slot = m_slots[i];
+        slot.firstFrame = static_cast<int>(m_frames.size());
+        slot.frameCount = 0;
+        slot.bounds = placed[i];
+        if (slot.image.data == nullptr) continue;
+
+        float frameWidth = placed[i].width / slot.columns;
+        float frameHeight = placed[i].height / slot.rows;
+        for (int row = 0; row < slot.rows; row++) {
+            for (int column = 0; column < slot.columns; column++) {
+                m_frames.push_back(Rectangle{ placed[i].x + column * frameWidth, placed[i].y + row * frameHeight,
+                                              frameWidth, frameHeight });
+            }
+        }
+        slot.frameCount = slot.columns * slot.rows;
+
+        if (slot.owned) UnloadImage(slot.image);
+        slot.image = Image{0};
+    }
+}
+
+bool SpriteAtlas::UploadRows(int maxBytes) {
+    if (m_pixels.data == nullptr) return m_texture.id != 0;
+
+    // Storage is allocated empty, then filled top to bottom
+    if (m_texture.id == 0) {
+        m_texture.id = rlLoadTexture(nullptr, m_pixels.width, m_pixels.height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+        m_texture.width = m_pixels.width;
+        m_texture.height = m_pixels.height;
+        m_texture.mipmaps = 1;
+        m_texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    }
+
+    const int rowBytes = m_pixels.width * 4;
+    const int rows = std::min(std::max(maxBytes / rowBytes, 1), m_pixels.height - m_uploadedRows);
+    const unsigned char* pixels = static_cast<const unsigned char*>(m_pixels.data);
+    UpdateTextureRec(m_texture, Rectangle{ 0, static_cast<float>(m_uploadedRows), static_cast<float>(m_pixels.width),
+                                           static_cast<float>(rows) },
+                     pixels + m_uploadedRows * rowBytes);
+    m_uploadedRows += rows;
+    if (m_uploadedRows < m_pixels.height) return false;
+
+    UnloadImage(m_pixels);
+    m_pixels = Image{0};
+    return true;
+}
+
+void SpriteAtlas::Unload() {
+    for (Slot& slot : m_slots) {
+        if (slot.image.data != nullptr && slot.owned) UnloadImage(slot.image);
+        slot = Slot{};
+    }
+    if (m_texture.id != 0) UnloadTexture(m_texture);
+    if (m_pixels.data != nullptr) UnloadImage(m_pixels);
+    m_texture = Texture2D{0};
+    m_pixels = Image{0};
+    m_uploadedRows = 0;
+    m_frames.clear();
+}
+
+Rectangle SpriteAtlas::Frame(SpriteId id, int frame) const {
+    const Slot& slot = m_slots[Index(id)];
+    if (slot.frameCount == 0) return Rectangle{ 0, 0, 0, 0 };
+    return m_frames[slot.firstFrame + frame % slot.frameCount];
+}
@@ -0,0 +1,71 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <vector>
+#include "raylib.h"
+
+// Sprite slots of a theme atlas; each theme maps its own art onto them
+enum class SpriteId {
+    Player,
+    Goal,
+    Obstacle,       // Asteroid/log spritesheet, or the desert cactus
+    ObstacleAlt,    // Desert tumbleweed
+    TimeBonus,
+    SpeedBoost,
+    Count
+};
+
+// Transparent gap around every packed sprite so neighbours never bleed into each other
+const int ATLAS_PADDING = 2;
+
+// One theme's sprites packed into a single texture at load time. Source
+// rectangles of every sprite, and of every frame of a spritesheet, are
+// computed once when packing so draw calls only look them up.
+class SpriteAtlas {
+public:
+    // Queue a sprite for the next Pack(); spritesheets pass their frame grid.
+    // The atlas takes ownership of the image unless owned is false, in which
+    // case the RGBA8 pixels (e.g. a mapped archive) must outlive PackImage().
+    void Add(SpriteId id, const char* fileName, int columns = 1, int rows = 1);
+    void Add(SpriteId id, Image image, int columns = 1, int rows = 1, bool owned = true);
+
+    // Shelf-pack the queued images into one texture and free them
+    void Pack();
+    // Pack() split in two: PackImage() only touches CPU memory and may run on
+    // a worker thread; UploadRows() then moves the packed pixels to the GPU a
+    // slice at a time and returns true once the texture is complete.
+    void PackImage();
+    bool UploadRows(int maxBytes);
+    void Unload();
+
+    // Frames index row-major into a spritesheet and wrap around
+    Rectangle Frame(SpriteId id, int frame = 0) const;
+    int getFrameCount(SpriteId id) const { return m_slots[Index(id)].frameCount; }
+    int getFrameColumns(SpriteId id) const { return m_slots[Index(id)].columns; }
+    // Whole sprite, every frame of a spritesheet included
+    Rectangle getBounds(SpriteId id) const { return m_slots[Index(id)].bounds; }
+    const Texture2D& getTexture() const { return m_texture; }
+    // Packed and fully uploaded
+    bool IsReady() const { return m_texture.id != 0 && m_pixels.data == nullptr; }
+
+private:
+    struct Slot {
+        Image image = {0};
+        bool owned = true;
+        int columns = 1;
+        int rows = 1;
+        int firstFrame = 0;
+        int frameCount = 0;
+        Rectangle bounds = {0, 0, 0, 0};
+    };
+
+    static int Index(SpriteId id) { return static_cast<int>(id); }
+
+    Slot m_slots[static_cast<int>(SpriteId::Count)];
+    std::vector<Rectangle> m_frames;
+    Texture2D m_texture = {0};
+    Image m_pixels = {0};           // Packed atlas still waiting for upload
+    int m_uploadedRows = 0;
+};
+
+#endif
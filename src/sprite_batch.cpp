@@ -0,0 +1,97 @@
+#include "sprite_batch.h"
+#include <algorithm>
+#include <cmath>
+#include "rlgl.h"
+
+void SpriteBatch::Draw(const Texture2D& texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    if (texture.id == 0) return;
+
+    // Flip and sign handling as in DrawTexturePro
+    bool flipX = false;
+    if (source.width < 0) { flipX = true; source.width *= -1; }
+    if (source.height < 0) source.y -= source.height;
+    if (dest.width < 0) dest.width *= -1;
+    if (dest.height < 0) dest.height *= -1;
+
+    Quad quad;
+    if (rotation == 0.0f) {
+        float x = dest.x - origin.x;
+        float y = dest.y - origin.y;
+        quad.topLeft = Vector2{ x, y };
+        quad.topRight = Vector2{ x + dest.width, y };
+        quad.bottomLeft = Vector2{ x, y + dest.height };
+        quad.bottomRight = Vector2{ x + dest.width, y + dest.height };
+    } else {
+        float sinRotation = sinf(rotation * DEG2RAD);
+        float cosRotation = cosf(rotation * DEG2RAD);
+        float dx = -origin.x;
+        float dy = -origin.y;
+        auto corner = [&](float offsetX, float offsetY) {
+            return Vector2{ dest.x + (dx + offsetX) * cosRotation - (dy + offsetY) * sinRotation,
+                            dest.y + (dx + offsetX) * sinRotation + (dy + offsetY) * cosRotation };
+        };
+        quad.topLeft = corner(0, 0);
+        quad.topRight = corner(dest.width, 0);
+        quad.bottomLeft = corner(0, dest.height);
+        quad.bottomRight = corner(dest.width, dest.height);
+    }
+
+    float left = source.x / texture.width;
+    float right = (source.x + source.width) / texture.width;
+    quad.u0 = flipX ? right : left;
+    quad.u1 = flipX ? left : right;
+    quad.v0 = source.y / texture.height;
+    quad.v1 = (source.y + source.height) / texture.height;
+    quad.tint = tint;
+
+    // Only a handful of atlases are live, so a linear search beats a map
+    auto run = std::find_if(m_runs.begin(), m_runs.end(),
+                            [&texture](const Run& r) { return r.textureId == texture.id; });
+    if (run == m_runs.end()) {
+        m_runs.push_back(Run{ texture.id, {} });
+        run = m_runs.end() - 1;
+    }
+    run->quads.push_back(quad);
+}
+
+void SpriteBatch::Flush() {
+    // Drop runs left over from unloaded atlases; the rest keep their capacity
+    m_runs.erase(std::remove_if(m_runs.begin(), m_runs.end(), [](const Run& r) { return r.quads.empty(); }),
+                 m_runs.end());
+
+    m_lastFlushCount = 0;
+    for (Run& run : m_runs) {
+        const int count = static_cast<int>(run.quads.size());
+        for (int start = 0; start < count; start += SPRITE_BATCH_CHUNK) {
+            const int end = std::min(start + SPRITE_BATCH_CHUNK, count);
+
+            rlCheckRenderBatchLimit((end - start) * 4);
+            rlSetTexture(run.textureId);
+            rlBegin(RL_QUADS);
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            for (int i = start; i < end; i++) {
+                const Quad& quad = run.quads[i];
+                rlColor4ub(quad.tint.r, quad.tint.g, quad.tint.b, quad.tint.a);
+                rlTexCoord2f(quad.u0, quad.v0);
+                rlVertex2f(quad.topLeft.x, quad.topLeft.y);
+                rlTexCoord2f(quad.u0, quad.v1);
+                rlVertex2f(quad.bottomLeft.x, quad.bottomLeft.y);
+                rlTexCoord2f(quad.u1, quad.v1);
+                rlVertex2f(quad.bottomRight.x, quad.bottomRight.y);
+                rlTexCoord2f(quad.u1, quad.v0);
+                rlVertex2f(quad.topRight.x, quad.topRight.y);
+            }
+            rlEnd();
+        }
+        rlSetTexture(0);
+
+        m_lastFlushCount += count;
+        run.quads.clear();
+    }
+}
+
+int SpriteBatch::getQueuedCount() const {
+    int count = 0;
+    for (const Run& run : m_runs) count += static_cast<int>(run.quads.size());
+    return count;
+}
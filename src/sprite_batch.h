@@ -0,0 +1,37 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <vector>
+#include "raylib.h"
+
+// Quads per rlBegin/rlEnd block, well inside rlgl's default batch buffer
+const int SPRITE_BATCH_CHUNK = 1024;
+
+// Collects textured quads over a frame and submits them in Flush(), grouped
+// by texture so every atlas is bound once however the draws were interleaved
+class SpriteBatch {
+public:
+    // Same arguments and result as DrawTexturePro, deferred until Flush()
+    void Draw(const Texture2D& texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint);
+    void Flush();
+
+    int getQueuedCount() const;
+    int getLastFlushCount() const { return m_lastFlushCount; }
+
+private:
+    struct Quad {
+        Vector2 topLeft, bottomLeft, bottomRight, topRight;
+        float u0, v0, u1, v1;
+        Color tint;
+    };
+
+    struct Run {
+        unsigned int textureId;
+        std::vector<Quad> quads;
+    };
+
+    std::vector<Run> m_runs;
+    int m_lastFlushCount = 0;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "star_field.h"
+#include <cmath>
+#include "rlgl.h"
+#include "rng.h"
+
+namespace {
+    // About 200 stars on the default 1920x1000 window, most of them far away
+    const StarLayer STAR_LAYER_SETTINGS[STAR_LAYERS] = {
+        { 96.0f, 0.7f, 0.5f, 0.05f },
+        { 160.0f, 0.6f, 0.5f, 0.15f },
+        { 256.0f, 0.5f, 1.0f, 0.35f },
+    };
+
+    const char* STAR_VERTEX_SHADER = R"(#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+out vec2 targetPosition;
+
+void main() {
+    targetPosition = vertexPosition.xy;
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+    const char* STAR_FRAGMENT_SHADER = R"(#version 330
+in vec2 targetPosition;
+out vec4 finalColor;
+
+uniform float pixelScale;       // Render target pixels per screen pixel
+uniform vec2 offsets[3];        // Per-layer scroll in pixels
+uniform vec4 layers[3];         // Cell size, density, radius
+
+float Hash(vec2 p) {
+    p = fract(p * vec2(123.34, 456.21));
+    p += dot(p, p + 45.32);
+    return fract(p.x * p.y);
+}
+
+void main() {
+    // Screen pixel, whatever the target's resolution; stars never shrink below one target pixel
+    vec2 pixel = targetPosition / pixelScale;
+    float coverage = 0.5 / pixelScale;
+
+    float alpha = 0.0;
+    for (int i = 0; i < 3; i++) {
+        float cellSize = layers[i].x;
+        float radius = layers[i].z;
+        vec2 p = pixel + offsets[i];
+        vec2 cell = floor(p / cellSize);
+        vec2 seed = cell + float(i) * 97.0;
+        if (Hash(seed) > layers[i].y) continue;
+
+        // Star centred on a pixel somewhere inside its cell
+        vec2 star = floor(vec2(Hash(seed + 11.0), Hash(seed + 23.0)) * (cellSize - 4.0)) + 2.5;
+        float distance = length(p - cell * cellSize - star);
+        float brightness = 0.5 + 0.5 * Hash(seed + 37.0);
+        alpha = max(alpha, brightness * clamp(radius + coverage - distance, 0.0, 1.0));
+    }
+    if (alpha <= 0.0) discard;
+    finalColor = vec4(1.0, 1.0, 1.0, alpha);
+}
+)";
+
+    // Top-left of the view scaled by the layer's parallax, in whole pixels so stars don't shimmer
+    Vector2 LayerOffset(const Camera2D& camera, int layer) {
+        const float parallax = STAR_LAYER_SETTINGS[layer].parallax;
+        return Vector2{ std::round((camera.target.x - camera.offset.x) * parallax),
+                        std::round((camera.target.y - camera.offset.y) * parallax) };
+    }
+}
+
+void StarField::Load() {
+    m_shader = LoadShaderFromMemory(STAR_VERTEX_SHADER, STAR_FRAGMENT_SHADER);
+    m_shaderReady = m_shader.id > 0 && m_shader.id != rlGetShaderIdDefault();
+    if (!m_shaderReady) {
+        TraceLog(LOG_WARNING, "STARS: Shader unavailable, drawing stars from a point list");
+        return;
+    }
+
+    m_pixelScaleLoc = GetShaderLocation(m_shader, "pixelScale");
+    m_offsetsLoc = GetShaderLocation(m_shader, "offsets");
+    m_layersLoc = GetShaderLocation(m_shader, "layers");
+
+    float layers[STAR_LAYERS * 4];
+    for (int i = 0; i < STAR_LAYERS; i++) {
+        layers[i * 4 + 0] = STAR_LAYER_SETTINGS[i].cellSize;
+        layers[i * 4 + 1] = STAR_LAYER_SETTINGS[i].density;
+        layers[i * 4 + 2] = STAR_LAYER_SETTINGS[i].radius;
+        layers[i * 4 + 3] = 0.0f;
+    }
+    SetShaderValueV(m_shader, m_layersLoc, layers, SHADER_UNIFORM_VEC4, STAR_LAYERS);
+}
+
+void StarField::BuildStars(int width, int height) {
+    m_stars.clear();
+    m_width = width;
+    m_height = height;
+
+    // Same density per layer as the shader, scattered by a fixed seed
+    Xoshiro256 rng(0x5747A125);
+    for (int layer = 0; layer < STAR_LAYERS; layer++) {
+        const StarLayer& settings = STAR_LAYER_SETTINGS[layer];
+        const int count = static_cast<int>(width * height / (settings.cellSize * settings.cellSize) * settings.density);
+        for (int i = 0; i < count; i++) {
+            m_stars.push_back(Star{
+                Vector2{ std::floor(rng.NextFloat() * width), std::floor(rng.NextFloat() * height) },
+                static_cast<unsigned char>(rng.NextRange(128, 255)),
+                layer
+            });
+        }
+    }
+}
+
+void StarField::Draw(const Camera2D& camera, int width, int height, float scale) {
+    if (m_shaderReady) {
+        float offsets[STAR_LAYERS * 2];
+        for (int i = 0; i < STAR_LAYERS; i++) {
+            const Vector2 offset = LayerOffset(camera, i);
+            offsets[i * 2 + 0] = offset.x;
+            offsets[i * 2 + 1] = offset.y;
+        }
+        SetShaderValue(m_shader, m_pixelScaleLoc, &scale, SHADER_UNIFORM_FLOAT);
+        SetShaderValueV(m_shader, m_offsetsLoc, offsets, SHADER_UNIFORM_VEC2, STAR_LAYERS);
+
+        BeginShaderMode(m_shader);
+        DrawRectangleRec(Rectangle{ 0, 0, width * scale, height * scale }, WHITE);
+        EndShaderMode();
+        return;
+    }
+
+    if (width != m_width || height != m_height) BuildStars(width, height);
+
+    // Stars wrap around the screen edges as their layer scrolls
+    Vector2 offsets[STAR_LAYERS];
+    for (int i = 0; i < STAR_LAYERS; i++) offsets[i] = LayerOffset(camera, i);
+    for (const Star& star : m_stars) {
+        float x = std::fmod(star.position.x - offsets[star.layer].x, static_cast<float>(width));
+        float y = std::fmod(star.position.y - offsets[star.layer].y, static_cast<float>(height));
+        if (x < 0) x += width;
+        if (y < 0) y += height;
+
+        const Color color = Color{ 255, 255, 255, star.alpha };
+        if (STAR_LAYER_SETTINGS[star.layer].radius > 0.5f) {
+            DrawCircleV(Vector2{ (x + 0.5f) * scale, (y + 0.5f) * scale }, STAR_LAYER_SETTINGS[star.layer].radius * scale, color);
+        } else {
+            DrawPixelV(Vector2{ std::floor(x * scale), std::floor(y * scale) }, color);
+        }
+    }
+}
+
+void StarField::Unload() {
+    if (m_shaderReady) UnloadShader(m_shader);
+    m_shader = Shader{0};
+    m_shaderReady = false;
+    m_stars.clear();
+    m_width = 0;
+    m_height = 0;
+}
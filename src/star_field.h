@@ -0,0 +1,50 @@
+#ifndef STAR_FIELD_H
+#define STAR_FIELD_H
+
+#include <vector>
+#include "raylib.h"
+
+// Parallax layers, far to near
+const int STAR_LAYERS = 3;
+
+struct StarLayer {
+    float cellSize;     // The screen is split into cells of this size, one candidate star each
+    float density;      // Chance a cell holds a star
+    float radius;       // Star radius in pixels
+    float parallax;     // Fraction of the camera's movement the layer follows
+};
+
+// Space background without a full-screen texture. A fragment shader hashes
+// every pixel's layer cell to decide where stars are, so nothing is stored and
+// any resolution works. Without GLSL 330 the same layers are drawn from a
+// small list of star points, rebuilt only when the resolution changes.
+class StarField {
+public:
+    void Load();
+    // Layers scroll with the camera at their own parallax rate. width and
+    // height are in screen pixels; scale shrinks the drawn area for a
+    // reduced-resolution render target without moving the stars.
+    void Draw(const Camera2D& camera, int width, int height, float scale = 1.0f);
+    void Unload();
+
+private:
+    struct Star {
+        Vector2 position;
+        unsigned char alpha;
+        int layer;
+    };
+
+    void BuildStars(int width, int height);
+
+    Shader m_shader = {0};
+    bool m_shaderReady = false;
+    int m_pixelScaleLoc = -1;
+    int m_offsetsLoc = -1;
+    int m_layersLoc = -1;
+
+    std::vector<Star> m_stars;      // CPU fallback, for m_width x m_height
+    int m_width = 0;
+    int m_height = 0;
+};
+
+#endif
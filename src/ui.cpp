@@ -1,19 +1,93 @@
 #include "ui.h"
 #include "game_state.h"
 #include "gameplay.h"
+#include "hud_text.h"
+#include "score_store.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <sstream>
 #include <fstream>
 #include <iomanip>
 
 std::vector<Score> highScores;
+// highScores formatted for the end menu; rebuilt only when the table changes
+std::vector<std::string> highScoreLines;
+
+void FormatHighScores() {
+    highScoreLines.clear();
+    for (const auto& score : highScores) {
+        highScoreLines.push_back(score.ToString());
+    }
+}
+
+namespace {
+    ScoreStore scoreStore;
+    // (difficulty, mode) bucket highScores holds, -1 when it needs reading again
+    int shownScoreBucket = -1;
+    // Log record of the score just set, highlighted on the end menu
+    long long newScoreRecord = -1;
+
+    // Layout of highscores.dat before the score log: raw Score structs as this build lays them out
+    struct LegacyScore {
+        float time;
+        bool wasTimed;
+        Difficulty difficulty;
+        std::time_t timestamp;
+    };
+
+    ScoreRecord MakeScoreRecord(float time, GameMode mode, Difficulty difficulty, std::time_t timestamp) {
+        ScoreRecord record = {};
+        record.timestamp = static_cast<int64_t>(timestamp);
+        record.timeMs = static_cast<uint32_t>(std::lround(std::max(time, 0.0f) * 1000.0f));
+        record.difficulty = static_cast<uint8_t>(difficulty);
+        record.mode = static_cast<uint8_t>(mode);
+        return record;
+    }
+
+    void MigrateLegacyScores() {
+        std::ifstream file(GAME_STATE.getScoresFile(), std::ios::binary);
+        if (!file) return;
+
+        LegacyScore score;
+        int migrated = 0;
+        while (file.read(reinterpret_cast<char*>(&score), sizeof(LegacyScore))) {
+            if (score.difficulty < Easy || score.difficulty > Hard || !(score.time >= 0.0f)) continue;
+            if (scoreStore.Append(MakeScoreRecord(score.time, score.wasTimed ? Timed : Untimed,
+                                                  score.difficulty, score.timestamp)) >= 0) {
+                migrated++;
+            }
+        }
+        file.close();
+
+        // Kept as a backup under another name so it is only moved over once
+        const std::string backup = std::string(GAME_STATE.getScoresFile()) + ".migrated";
+        std::rename(GAME_STATE.getScoresFile(), backup.c_str());
+        TraceLog(LOG_INFO, "SCORES: Moved %d scores from %s into %s", migrated, GAME_STATE.getScoresFile(), SCORE_LOG_FILE);
+    }
+
+    // Best scores of one difficulty and mode; the log is only read when the bucket changes
+    void ShowHighScores(Difficulty difficulty, GameMode mode) {
+        const int bucket = static_cast<int>(difficulty) * SCORE_MODES + static_cast<int>(mode);
+        if (bucket == shownScoreBucket) return;
+        shownScoreBucket = bucket;
+
+        highScores.clear();
+        for (const ScoreRecord& record : scoreStore.Top(difficulty, mode, MAX_HIGH_SCORES)) {
+            highScores.push_back(Score(record.timeMs / 1000.0f, record.mode == Timed, static_cast<Difficulty>(record.difficulty),
+                                       static_cast<std::time_t>(record.timestamp), record.sequence));
+        }
+        FormatHighScores();
+    }
+}
 
 
 bool Score::operator<(const Score& rhs) const {
     return time < rhs.time;
 }
 
-Score::Score(float t, bool timed, Difficulty diff, std::time_t ts)
-    : time(t), wasTimed(timed), difficulty(diff), timestamp(ts) {}
+Score::Score(float t, bool timed, Difficulty diff, std::time_t ts, long long rec)
+    : time(t), wasTimed(timed), difficulty(diff), timestamp(ts), record(rec) {}
 
 std::string Score::ToString() const {
     std::stringstream ss;
@@ -56,157 +130,153 @@ std::string Score::ToString() const {
 }
 
 void LoadHighScores() {
-    std::ifstream file(GAME_STATE.getScoresFile(), std::ios::binary);
-    if (!file) return;
-
-    highScores.clear();
-    Score score;
-    while (file.read(reinterpret_cast<char*>(&score), sizeof(Score))) {
-        highScores.push_back(score);
+    if (!scoreStore.Open(SCORE_LOG_FILE, SCORE_INDEX_FILE)) {
+        TraceLog(LOG_WARNING, "SCORES: Could not open %s, scores will not be kept", SCORE_LOG_FILE);
+        return;
     }
-}
-
-void SaveHighScores() {
-    std::ofstream file(GAME_STATE.getScoresFile(), std::ios::binary);
-    if (!file) return;
-
-    for (const auto& score : highScores) {
-        file.write(reinterpret_cast<const char*>(&score), sizeof(Score));
+    if (scoreStore.getRecordCount() == 0) MigrateLegacyScores();
+    if (scoreStore.getCorruptRecords() > 0) {
+        TraceLog(LOG_WARNING, "SCORES: Skipped %lld damaged records in %s", scoreStore.getCorruptRecords(), SCORE_LOG_FILE);
     }
+    shownScoreBucket = -1;
 }
 
 void AddHighScore(float time, bool wasTimed) {
     // Don't add if game wasn't won
     if (!GAME_STATE.getGameWon()) return;
-    
-    // Create new score with current UTC timestamp
-    Score newScore(time, wasTimed, GAME_STATE.getCurrentDifficulty(), std::time(nullptr));
-    
-    // Insert score in sorted order by completion time
-    auto it = std::lower_bound(highScores.begin(), highScores.end(), newScore);
-    
-    highScores.insert(it, newScore);
-    
-    // Keep only top scores
-    if (highScores.size() > MAX_HIGH_SCORES) {
-        highScores.resize(MAX_HIGH_SCORES);
-    }
-    
-    SaveHighScores();
+
+    // Every finished run is kept; the end menu shows the best of its difficulty and mode
+    const GameMode mode = wasTimed ? Timed : Untimed;
+    newScoreRecord = scoreStore.Append(MakeScoreRecord(time, mode, GAME_STATE.getCurrentDifficulty(), std::time(nullptr)));
+    shownScoreBucket = -1;
 }
 void DrawDifficultyMenu() {
-    DrawText("Select Difficulty", GAME_STATE.getScreenWidth()/2 - MeasureText("Select Difficulty", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 100, 20, ORANGE);
-    DrawText("1. Easy", GAME_STATE.getScreenWidth()/2 - MeasureText("1. Easy", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 60, 20, GREEN);
-    DrawText("2. Medium", GAME_STATE.getScreenWidth()/2 - MeasureText("2. Medium", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 20, 20, YELLOW);
-    DrawText("3. Hard", GAME_STATE.getScreenWidth()/2 - MeasureText("3. Hard", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 20, 20, DARKBLUE);
-    DrawText("4. Quit", GAME_STATE.getScreenWidth() / 2 - MeasureText("4. Quit", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 60, 20, RED);
+    HudText::DrawLabelCentered("Select Difficulty", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 100, 20, ORANGE);
+    HudText::DrawLabelCentered("1. Easy", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 60, 20, GREEN);
+    HudText::DrawLabelCentered("2. Medium", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 20, 20, YELLOW);
+    HudText::DrawLabelCentered("3. Hard", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 20, 20, DARKBLUE);
+    HudText::DrawLabelCentered("4. Quit", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 60, 20, RED);
 }
 void DrawModeMenu() {
     // Game mode options
-    DrawText("Select Game Mode", GAME_STATE.getScreenWidth() / 2 - MeasureText("Select Game Mode", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 100, 20, ORANGE);
-    DrawText("1. Timed", GAME_STATE.getScreenWidth() / 2 - MeasureText("1. Timed", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 60, 20, ORANGE);
-    DrawText("2. Untimed", GAME_STATE.getScreenWidth() / 2 - MeasureText("2. Untimed", 20) / 2, GAME_STATE.getScreenHeight() / 2 - 20, 20, ORANGE);
-    DrawText("3. Change Difficulty", GAME_STATE.getScreenWidth() / 2 - MeasureText("3. Change Difficulty", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 20, 20, ORANGE);
-    DrawText("4. Quit", GAME_STATE.getScreenWidth() / 2 - MeasureText("4. Quit", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 60, 20, RED);
+    HudText::DrawLabelCentered("Select Game Mode", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 100, 20, ORANGE);
+    HudText::DrawLabelCentered("1. Timed", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 60, 20, ORANGE);
+    HudText::DrawLabelCentered("2. Untimed", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 - 20, 20, ORANGE);
+    HudText::DrawLabelCentered("3. Endless", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 20, 20, ORANGE);
+    HudText::DrawLabelCentered("4. Change Difficulty", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 60, 20, ORANGE);
+    HudText::DrawLabelCentered("5. Quit", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 100, 20, RED);
 
     // Gameplay instructions
-    DrawText("Game Controls:", GAME_STATE.getScreenWidth() / 2 - MeasureText("Game Controls:", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 140, 20, LIGHTGRAY);
-    DrawText("Arrow Keys/WASD - Move", GAME_STATE.getScreenWidth() / 2 - MeasureText("Arrow Keys/WASD - Move", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 170, 20, LIGHTGRAY);
-    DrawText("P - Pause Game", GAME_STATE.getScreenWidth() / 2 - MeasureText("P - Pause Game", 20) / 2, GAME_STATE.getScreenHeight() / 2 + 200, 20, LIGHTGRAY);
+    HudText::DrawLabelCentered("Game Controls:", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 140, 20, LIGHTGRAY);
+    HudText::DrawLabelCentered("Arrow Keys/WASD - Move", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 170, 20, LIGHTGRAY);
+    HudText::DrawLabelCentered("P - Pause Game", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight() / 2 + 200, 20, LIGHTGRAY);
 }
 void DrawEndMenu(bool gameWon, float completionTime) {
     const int baseY = GAME_STATE.getScreenHeight() / 4;
 
     if (gameWon) {
-        // Convert total time to hours, minutes, seconds
-        int hours = static_cast<int>(completionTime) / 3600;
-        int minutes = (static_cast<int>(completionTime) % 3600) / 60;
-        float seconds = completionTime - (hours * 3600 + minutes * 60);
-
-        // Create formatted time string
-        char timeStr[50];
-        if (hours > 0) {
-            snprintf(timeStr, sizeof(timeStr), "Completion Time: %d:%02d:%05.2f", hours, minutes, seconds);
-        } else if (minutes > 0) {
-            snprintf(timeStr, sizeof(timeStr), "Completion Time: %d:%05.2f", minutes, seconds);
-        } else {
-            snprintf(timeStr, sizeof(timeStr), "Completion Time: %.2f seconds", seconds);
+        // Formatted once per result rather than every frame
+        static float formattedTime = -1.0f;
+        static char timeStr[50];
+        if (completionTime != formattedTime) {
+            formattedTime = completionTime;
+
+            // Convert total time to hours, minutes, seconds
+            int hours = static_cast<int>(completionTime) / 3600;
+            int minutes = (static_cast<int>(completionTime) % 3600) / 60;
+            float seconds = completionTime - (hours * 3600 + minutes * 60);
+
+            if (hours > 0) {
+                snprintf(timeStr, sizeof(timeStr), "Completion Time: %d:%02d:%05.2f", hours, minutes, seconds);
+            } else if (minutes > 0) {
+                snprintf(timeStr, sizeof(timeStr), "Completion Time: %d:%05.2f", minutes, seconds);
+            } else {
+                snprintf(timeStr, sizeof(timeStr), "Completion Time: %.2f seconds", seconds);
+            }
         }
 
-        DrawText("You Win!", GAME_STATE.getScreenWidth() / 2 - MeasureText("You Win!", 50) / 2, baseY - 50, 50, DARKGREEN);
-        DrawText(timeStr, GAME_STATE.getScreenWidth() / 2 - MeasureText(timeStr, 20) / 1.3, baseY, 30, DARKGREEN);
+        HudText::DrawLabelCentered("You Win!", GAME_STATE.getScreenWidth() / 2, baseY - 50, 50, DARKGREEN);
+        HudText::DrawLabelCentered(timeStr, GAME_STATE.getScreenWidth() / 2, baseY, 30, DARKGREEN);
+    } else if (GAME_STATE.getCurrentMode() == Endless) {
+        static HudNumber depthReached("Depth Reached: ", 0, 30);
+        depthReached.Set(static_cast<double>(GAME_STATE.getEndlessDepth()));
+        HudText::DrawLabelCentered("Time's Up!", GAME_STATE.getScreenWidth() / 2, baseY - 50, 40, ORANGE);
+        depthReached.Draw(GAME_STATE.getScreenWidth() / 2 - depthReached.getWidth() / 2, baseY, ORANGE);
     } else {
-        DrawText("You Lost", GAME_STATE.getScreenWidth() / 2 - MeasureText("You Lost", 40) / 2.2, baseY - 50, 40, RED);
-        DrawText("Better Luck Next Time", GAME_STATE.getScreenWidth() / 2 - MeasureText("Better Luck Next Time", 20) / 1.3, baseY, 30, RED);
+        HudText::DrawLabelCentered("You Lost", GAME_STATE.getScreenWidth() / 2, baseY - 50, 40, RED);
+        HudText::DrawLabelCentered("Better Luck Next Time", GAME_STATE.getScreenWidth() / 2, baseY, 30, RED);
     }
 
-    // Draw high scores table
+    // Draw high scores table; endless runs never reach an exit, so they set no times
     const int scoreStartY = baseY + 80;
-    DrawText("HIGH SCORES", 
-            GAME_STATE.getScreenWidth()/2 - MeasureText("HIGH SCORES", 25)/2,
-            scoreStartY, 25, {0, 255, 255, 255});
-    
-    const int lineHeight = 25;
-    for (size_t i = 0; i < highScores.size(); i++) {
-        Color textColor = WHITE;
-        // Highlight new score
-        if (gameWon && highScores[i].time == completionTime && 
-            highScores[i].wasTimed == (GAME_STATE.getCurrentMode() == Timed) &&
-            highScores[i].difficulty == GAME_STATE.getCurrentDifficulty()) {
-            textColor = YELLOW;
+    if (GAME_STATE.getCurrentMode() != Endless) {
+        HudText::DrawLabelCentered("HIGH SCORES", GAME_STATE.getScreenWidth() / 2, scoreStartY, 25, {0, 255, 255, 255});
+
+        const int lineHeight = 25;
+        ShowHighScores(GAME_STATE.getCurrentDifficulty(), GAME_STATE.getCurrentMode());
+        for (size_t i = 0; i < highScores.size(); i++) {
+            Color textColor = WHITE;
+            // Highlight new score
+            if (gameWon && highScores[i].record >= 0 && highScores[i].record == newScoreRecord) {
+                textColor = YELLOW;
+            }
+
+            HudText::DrawLabelCentered(highScoreLines[i].c_str(), GAME_STATE.getScreenWidth() / 2,
+                                       scoreStartY + 40 + (i * lineHeight), 20, textColor);
         }
-        
-        std::string scoreText = highScores[i].ToString();
-        DrawText(scoreText.c_str(),
-                GAME_STATE.getScreenWidth()/2 - MeasureText(scoreText.c_str(), 20)/2,
-                scoreStartY + 40 + (i * lineHeight), 20, textColor);
     }
     
     // Draw end menu options at bottom
     const int optionsY = scoreStartY + 300;
-    DrawText("1. Play Again", GAME_STATE.getScreenWidth() / 2 - MeasureText("1. Play Again", 20) / 2, optionsY, 20, ORANGE);
-    DrawText("2. Change Game Mode", GAME_STATE.getScreenWidth() / 2 - MeasureText("2. Change Game Mode", 20) / 2, optionsY + 30, 20, ORANGE);
-    DrawText("3. Quit", GAME_STATE.getScreenWidth() / 2 - MeasureText("3. Quit", 20) / 2, optionsY + 60, 20, RED);
+    HudText::DrawLabelCentered("1. Play Again", GAME_STATE.getScreenWidth() / 2, optionsY, 20, ORANGE);
+    HudText::DrawLabelCentered("2. Change Game Mode", GAME_STATE.getScreenWidth() / 2, optionsY + 30, 20, ORANGE);
+    HudText::DrawLabelCentered("3. Quit", GAME_STATE.getScreenWidth() / 2, optionsY + 60, 20, RED);
 }
 void HandleMenuInput() {
     if (GAME_STATE.getCurrentGameState() == StartMenu) {
         if (GAME_STATE.getMenuState() == DifficultySelect) {
             if (IsKeyPressed(KEY_ONE)) {
-                PlaySound(GameResources::menuSound);
+                GameResources::sfx.Play(SfxId::Menu);
                 GAME_STATE.setCurrentDifficulty(Easy);
                 GAME_STATE.setMenuState(ModeSelect);
             } else if (IsKeyPressed(KEY_TWO)) {
-                PlaySound(GameResources::menuSound);
+                GameResources::sfx.Play(SfxId::Menu);
                 GAME_STATE.setCurrentDifficulty(Medium);
                 GAME_STATE.setMenuState(ModeSelect);
             } else if (IsKeyPressed(KEY_THREE)) {
-                PlaySound(GameResources::menuSound);
+                GameResources::sfx.Play(SfxId::Menu);
                 GAME_STATE.setCurrentDifficulty(Hard);
                 GAME_STATE.setMenuState(ModeSelect);
             } else if (IsKeyPressed(KEY_FOUR)) {
-                PlaySound(GameResources::menuSound);
+                GameResources::sfx.Play(SfxId::Menu);
                 GameResources::UnloadAllResources();
                 CloseWindow();
                 exit(0);
             }
         } else if (GAME_STATE.getMenuState() == ModeSelect) {
             if (IsKeyPressed(KEY_ONE)) {
-                PlaySound(GameResources::startSound);
+                GameResources::sfx.Play(SfxId::Start);
                 GAME_STATE.setCurrentMode(Timed);
                 GAME_STATE.setCurrentGameState(Playing);
                 InitializeGameWithDifficulty();
                 GAME_STATE.setStartTime(GetTime());
             } else if (IsKeyPressed(KEY_TWO)) {
-                PlaySound(GameResources::startSound);
+                GameResources::sfx.Play(SfxId::Start);
                 GAME_STATE.setCurrentMode(Untimed);
                 GAME_STATE.setCurrentGameState(Playing);
                 InitializeGameWithDifficulty();
                 GAME_STATE.setStartTime(GetTime());
             } else if (IsKeyPressed(KEY_THREE)) {
-                PlaySound(GameResources::menuSound);
-                GAME_STATE.setMenuState(DifficultySelect);
+                GameResources::sfx.Play(SfxId::Start);
+                GAME_STATE.setCurrentMode(Endless);
+                GAME_STATE.setCurrentGameState(Playing);
+                InitializeGameWithDifficulty();
+                GAME_STATE.setStartTime(GetTime());
             } else if (IsKeyPressed(KEY_FOUR)) {
-                PlaySound(GameResources::menuSound);
+                GameResources::sfx.Play(SfxId::Menu);
+                GAME_STATE.setMenuState(DifficultySelect);
+            } else if (IsKeyPressed(KEY_FIVE)) {
+                GameResources::sfx.Play(SfxId::Menu);
                 GameResources::UnloadAllResources();
                 CloseWindow();
                 exit(0);
@@ -215,15 +285,15 @@ void HandleMenuInput() {
     } else if (GAME_STATE.getCurrentGameState() == EndMenu) {
         if (IsKeyPressed(KEY_ONE)) {
             RandomizeTheme();
-            PlaySound(GameResources::startSound);
+            GameResources::sfx.Play(SfxId::Start);
             ResetGame();
             GAME_STATE.setCurrentGameState(Playing);
         } else if (IsKeyPressed(KEY_TWO)) {
             RandomizeTheme();
-            PlaySound(GameResources::menuSound);
+            GameResources::sfx.Play(SfxId::Menu);
             GAME_STATE.setCurrentGameState(StartMenu);
         } else if (IsKeyPressed(KEY_THREE)) {
-            PlaySound(GameResources::menuSound);
+            GameResources::sfx.Play(SfxId::Menu);
             GameResources::UnloadAllResources();
             CloseWindow();
             exit(0);
@@ -244,23 +314,13 @@ void UpdateSoundSettings() {
                     SetMusicVolume(GameResources::desertAmbient, 1.0);
                     break;
             }
-            SetSoundVolume(GameResources::startSound, 1.0f);
-            SetSoundVolume(GameResources::blockedSound, 1.0f);
-            SetSoundVolume(GameResources::winSound, 1.0f);
-            SetSoundVolume(GameResources::loseSound, 1.0f);
-            SetSoundVolume(GameResources::menuSound, 1.0f);
-            SetSoundVolume(GameResources::bonusSound, 1.0f);
+            GameResources::sfx.SetVolume(1.0f);
             break;
         case SoundSettings::MusicOff:
             SetMusicVolume(GameResources::spaceAmbient, 0.0f);
             SetMusicVolume(GameResources::jungleAmbient, 0.0f);
             SetMusicVolume(GameResources::desertAmbient, 0.0f);
-            SetSoundVolume(GameResources::startSound, 1.0f);
-            SetSoundVolume(GameResources::blockedSound, 1.0f);
-            SetSoundVolume(GameResources::winSound, 1.0f);
-            SetSoundVolume(GameResources::loseSound, 1.0f);
-            SetSoundVolume(GameResources::menuSound, 1.0f);
-            SetSoundVolume(GameResources::bonusSound, 1.0f);
+            GameResources::sfx.SetVolume(1.0f);
             break;
         case SoundSettings::SoundOff:
             switch(GAME_STATE.getCurrentTheme()) {
@@ -274,23 +334,13 @@ void UpdateSoundSettings() {
                     SetMusicVolume(GameResources::desertAmbient, 1.0);
                     break;
             }
-            SetSoundVolume(GameResources::startSound, 0.0f);
-            SetSoundVolume(GameResources::blockedSound, 0.0f);
-            SetSoundVolume(GameResources::winSound, 0.0f);
-            SetSoundVolume(GameResources::loseSound, 0.0f);
-            SetSoundVolume(GameResources::menuSound, 0.0f);
-            SetSoundVolume(GameResources::bonusSound, 0.0f);
+            GameResources::sfx.SetVolume(0.0f);
             break;
         case SoundSettings::AllOff:
             SetMusicVolume(GameResources::spaceAmbient, 0.0f);
             SetMusicVolume(GameResources::jungleAmbient, 0.0f);
             SetMusicVolume(GameResources::desertAmbient, 0.0f);
-            SetSoundVolume(GameResources::startSound, 0.0f);
-            SetSoundVolume(GameResources::blockedSound, 0.0f);
-            SetSoundVolume(GameResources::winSound, 0.0f);
-            SetSoundVolume(GameResources::loseSound, 0.0f);
-            SetSoundVolume(GameResources::menuSound, 0.0f);
-            SetSoundVolume(GameResources::bonusSound, 0.0f);
+            GameResources::sfx.SetVolume(0.0f);
             break;
     }
 }
@@ -299,18 +349,57 @@ void DrawPauseMenu() {
     DrawRectangle(0, 0, GAME_STATE.getScreenWidth(), GAME_STATE.getScreenHeight(), ColorAlpha(BLACK, 0.5f));
     
     // Draw settings menu
-    DrawText("GAME PAUSED", GAME_STATE.getScreenWidth()/2 - MeasureText("GAME PAUSED", 40)/2, GAME_STATE.getScreenHeight()/2 - 150, 40, WHITE);
+    HudText::DrawLabelCentered("GAME PAUSED", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 - 150, 40, WHITE);
     
     // Sound settings
-    DrawText("Sound Settings:", GAME_STATE.getScreenWidth()/2 - MeasureText("Sound Settings:", 20)/2, GAME_STATE.getScreenHeight()/2 - 50, 20, WHITE);
-    DrawText("1. All Sounds ON", GAME_STATE.getScreenWidth()/2 - MeasureText("1. All Sounds ON", 20)/2, GAME_STATE.getScreenHeight()/2, 20, 
+    HudText::DrawLabelCentered("Sound Settings:", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 - 50, 20, WHITE);
+    HudText::DrawLabelCentered("1. All Sounds ON", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2, 20,
              GAME_STATE.getSoundSettings() == SoundSettings::AllOn ? GREEN : GRAY);
-    DrawText("2. Music OFF", GAME_STATE.getScreenWidth()/2 - MeasureText("2. Music OFF", 20)/2, GAME_STATE.getScreenHeight()/2 + 30, 20,
+    HudText::DrawLabelCentered("2. Music OFF", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 + 30, 20,
              GAME_STATE.getSoundSettings() == SoundSettings::MusicOff ? GREEN : GRAY);
-    DrawText("3. Sound Effects OFF", GAME_STATE.getScreenWidth()/2 - MeasureText("3. Sound Effects OFF", 20)/2, GAME_STATE.getScreenHeight()/2 + 60, 20,
+    HudText::DrawLabelCentered("3. Sound Effects OFF", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 + 60, 20,
              GAME_STATE.getSoundSettings() == SoundSettings::SoundOff ? GREEN : GRAY);
-    DrawText("4. All Sounds OFF", GAME_STATE.getScreenWidth()/2 - MeasureText("4. All Sounds OFF", 20)/2, GAME_STATE.getScreenHeight()/2 + 90, 20,
+    HudText::DrawLabelCentered("4. All Sounds OFF", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 + 90, 20,
              GAME_STATE.getSoundSettings() == SoundSettings::AllOff ? GREEN : GRAY);
     
-    DrawText("P - Resume Game", GAME_STATE.getScreenWidth()/2 - MeasureText("P - Resume Game", 20)/2, GAME_STATE.getScreenHeight()/2 + 150, 20, LIGHTGRAY);
-}
\ No newline at end of file
+    HudText::DrawLabelCentered("P - Resume Game", GAME_STATE.getScreenWidth() / 2, GAME_STATE.getScreenHeight()/2 + 150, 20, LIGHTGRAY);
+}
+
+void DrawPlayingHud() {
+    // Labels are rasterized once; the numbers are re-laid out only when their shown digits change
+    static HudNumber timeLeftText("Time Left: ", 2, 20);
+    static HudNumber bonusText(" + ", 1, 20);
+    static HudNumber timerText("Time: ", 2, 20);
+    static HudNumber depthText("Depth: ", 0, 20);
+    static HudNumber speedBoostText("Speed Boost: ", 2, 20, "s");
+
+    if (GAME_STATE.getCurrentMode() == Timed || GAME_STATE.getCurrentMode() == Endless) {
+        float timeLeft = GAME_STATE.getTimeLimit() - GAME_STATE.getTimeElapsed();
+        timeLeftText.Set(timeLeft);
+        if (GAME_STATE.getShowTimeBonusFeedback()) {
+            // Draw Time Left and Time Bonus at distinct positions
+            bonusText.Set(GAME_STATE.getTimeBonusAmount());
+            timeLeftText.Draw(10, 8, WHITE);
+            bonusText.Draw(10 + timeLeftText.getWidth(), 8, GREEN); // Positioned next the main timer
+        } else {
+            timeLeftText.Draw(10, 8, (timeLeft < 10.0f) ? RED : WHITE);
+        }
+
+        if (GAME_STATE.getCurrentMode() == Endless) {
+            depthText.Set(static_cast<double>(GAME_STATE.getEndlessDepth()));
+            depthText.Draw(400, 8, WHITE);
+        }
+    } else {
+        timerText.Set(GAME_STATE.getTimeElapsed());
+        timerText.Draw(10, 8, WHITE);
+    }
+
+    // Draw pause hint in top-right corner
+    const char* pauseHint = "P - Pause/Settings";
+    HudText::DrawLabel(pauseHint, GAME_STATE.getScreenWidth() - HudText::MeasureLabel(pauseHint, 20) - 10, 8, 20, LIGHTGRAY);
+
+    if (GAME_STATE.getIsSpeedBoosted()) {
+        speedBoostText.Set(GAME_STATE.getSpeedBoostTimeLeft());
+        speedBoostText.Draw(900, 8, YELLOW);
+    }
+}
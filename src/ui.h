@@ -11,19 +11,20 @@ struct Score {
     bool wasTimed;
     Difficulty difficulty;
     std::time_t timestamp;
+    long long record;           // Number in the score log, -1 when not stored
     bool operator<(const Score& rhs) const;
     
     Score(float t = 0.0f, bool timed = false, 
-          Difficulty diff = Easy, std::time_t ts = 0);
+          Difficulty diff = Easy, std::time_t ts = 0, long long rec = -1);
     std::string ToString() const;
 };
 
-// Leaderboard variables and file
+// Leaderboard of the current difficulty and mode, read from the score log
 extern std::vector<Score> highScores;
 const int MAX_HIGH_SCORES = 10;
 
+// Opens the score log, moving an old highscores.dat into it on first run
 void LoadHighScores();
-void SaveHighScores();
 void AddHighScore(float time, bool wasTimed);
 void DrawDifficultyMenu();
 void DrawModeMenu();
@@ -31,5 +32,6 @@ void DrawEndMenu(bool gameWon, float completionTime);
 void HandleMenuInput();
 void UpdateSoundSettings();
 void DrawPauseMenu();
+void DrawPlayingHud();
 
 #endif
\ No newline at end of file
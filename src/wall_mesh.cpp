@@ -0,0 +1,51 @@
+#include "wall_mesh.h"
+#include "raymath.h"
+
+void WallMesh::Build(const std::vector<WallSegment>& segments, Vector2 origin, float cellSize, float thickness) {
+    m_segmentCount = static_cast<int>(segments.size());
+
+    if (m_mesh.vaoId != 0) UnloadMesh(m_mesh);
+    m_mesh = Mesh{0};
+    if (m_material.maps == nullptr) m_material = LoadMaterialDefault();
+    if (segments.empty()) return;
+
+    // Two triangles per segment, no index buffer (16-bit indices would cap large mazes)
+    m_mesh.vertexCount = m_segmentCount * 6;
+    m_mesh.triangleCount = m_segmentCount * 2;
+    m_mesh.vertices = static_cast<float*>(MemAlloc(m_mesh.vertexCount * 3 * sizeof(float)));
+
+    const float half = thickness * 0.5f;
+    float* v = m_mesh.vertices;
+    for (const WallSegment& segment : segments) {
+        // Extend both ends by half the thickness so corners close up
+        float left = origin.x + segment.x0 * cellSize - half;
+        float top = origin.y + segment.y0 * cellSize - half;
+        float right = origin.x + segment.x1 * cellSize + half;
+        float bottom = origin.y + segment.y1 * cellSize + half;
+
+        // Same winding as raylib's rectangles: top-left, bottom-left, bottom-right, top-right
+        const float quad[6][2] = {{left, top}, {left, bottom}, {right, bottom},
+                                  {left, top}, {right, bottom}, {right, top}};
+        for (const auto& corner : quad) {
+            *v++ = corner[0];
+            *v++ = corner[1];
+            *v++ = 0.0f;
+        }
+    }
+
+    UploadMesh(&m_mesh, false);
+}
+
+void WallMesh::Draw(Color color) {
+    if (m_mesh.vaoId == 0) return;
+    m_material.maps[MATERIAL_MAP_DIFFUSE].color = color;
+    DrawMesh(m_mesh, m_material, MatrixIdentity());
+}
+
+void WallMesh::Unload() {
+    if (m_mesh.vaoId != 0) UnloadMesh(m_mesh);
+    if (m_material.maps != nullptr) UnloadMaterial(m_material);
+    m_mesh = Mesh{0};
+    m_material = Material{0};
+    m_segmentCount = 0;
+}
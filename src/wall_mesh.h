@@ -0,0 +1,28 @@
+#ifndef WALL_MESH_H
+#define WALL_MESH_H
+
+#include <vector>
+#include "raylib.h"
+#include "wall_segments.h"
+
+// Wall quad thickness in pixels (1 matches the old DrawLine walls)
+const float WALL_THICKNESS = 1.0f;
+
+// Merged wall segments as one triangle buffer: each segment is expanded into
+// a thick quad, uploaded once and drawn with a single DrawMesh call
+class WallMesh {
+public:
+    // Re-uploads the vertex buffer; origin is the pixel position of grid corner (0, 0)
+    void Build(const std::vector<WallSegment>& segments, Vector2 origin, float cellSize, float thickness = WALL_THICKNESS);
+    void Draw(Color color);
+    void Unload();
+
+    int getSegmentCount() const { return m_segmentCount; }
+
+private:
+    int m_segmentCount = 0;
+    Mesh m_mesh = {0};
+    Material m_material = {0};
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "wall_segments.h"
+
+int BuildWallSegments(const MazeGrid& grid, std::vector<WallSegment>& segments) {
+    const int cols = grid.getColumns();
+    const int rows = grid.getRows();
+    segments.clear();
+
+    int perCell = 0;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            uint8_t walls = grid.Walls(x, y);
+            perCell += (walls & 1) + ((walls >> 1) & 1) + ((walls >> 2) & 1) + ((walls >> 3) & 1);
+        }
+    }
+
+    // Horizontal grid line y is the top of row y and the bottom of row y - 1
+    for (int y = 0; y <= rows; y++) {
+        int runStart = -1;
+        for (int x = 0; x <= cols; x++) {
+            bool edge = x < cols && ((y < rows && grid.HasWall(x, y, 0)) || (y > 0 && grid.HasWall(x, y - 1, 2)));
+            if (edge && runStart < 0) {
+                runStart = x;
+            } else if (!edge && runStart >= 0) {
+                segments.push_back({runStart, y, x, y});
+                runStart = -1;
+            }
+        }
+    }
+
+    // Vertical grid line x is the left of column x and the right of column x - 1
+    for (int x = 0; x <= cols; x++) {
+        int runStart = -1;
+        for (int y = 0; y <= rows; y++) {
+            bool edge = y < rows && ((x < cols && grid.HasWall(x, y, 3)) || (x > 0 && grid.HasWall(x - 1, y, 1)));
+            if (edge && runStart < 0) {
+                runStart = y;
+            } else if (!edge && runStart >= 0) {
+                segments.push_back({x, runStart, x, y});
+                runStart = -1;
+            }
+        }
+    }
+
+    return perCell;
+}
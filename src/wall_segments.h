@@ -0,0 +1,19 @@
+#ifndef WALL_SEGMENTS_H
+#define WALL_SEGMENTS_H
+
+#include <vector>
+#include "maze_grid.h"
+
+// Axis-aligned wall run between two grid corners, in cell units
+struct WallSegment {
+    int x0, y0;
+    int x1, y1;
+};
+
+// Collects every wall edge exactly once (a wall shared by two cells is one
+// edge) and merges collinear neighbours into maximal horizontal and vertical
+// runs. Returns the number of per-cell segments the same walls take when each
+// cell draws its own four sides, for comparison.
+int BuildWallSegments(const MazeGrid& grid, std::vector<WallSegment>& segments);
+
+#endif
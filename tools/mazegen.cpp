@@ -0,0 +1,221 @@
+// Headless bulk maze generator built on the raylib-free maze core.
+// Builds N mazes exactly as the game would for the same maze seeds, spread over
+// all cores, and reports throughput. Maze i uses seed (--seed + i).
+//
+// Optional text output (--out) writes, per maze, a header line followed by one
+// line per row with one character per cell: the hex wall nibble (top=1, right=2,
+// bottom=4, left=8), shifted to 'g'..'v' when the cell holds an obstacle.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <omp.h>
+#include "maze_builder.h"
+#include "maze_grid.h"
+
+namespace {
+    struct Options {
+        long long count = 1000;
+        int columns = 77;   // The Hard grid of a 1920x1000 window
+        int rows = 39;
+        Difficulty difficulty = Medium;
+        bool overrideAlgorithm = false;
+        MazeAlgorithm algorithm = MazeAlgorithm::Backtracker;
+        GenerationMode generation = GenerationMode::Serial;
+        uint64_t seed = 1;
+        int threads = 0;    // 0: all cores
+        const char* outPath = nullptr;
+    };
+
+    void PrintUsage() {
+        std::printf(
+            "usage: mazegen [options]\n"
+            "  -n, --count N          mazes to build (default 1000)\n"
+            "  -s, --size WxH         grid size in cells, at least %dx%d (default 77x39)\n"
+            "  -d, --difficulty D     easy | medium | hard (default medium)\n"
+            "  -a, --algorithm A      backtracker | kruskal | prim | wilson | binarytree | sidewinder\n"
+            "                         (default: the difficulty's algorithm)\n"
+            "      --seed S           seed of the first maze; maze i uses S + i (default 1)\n"
+            "      --tiled            carve each maze in %d-cell tiles (GenerationMode::Parallel)\n"
+            "  -t, --threads T        worker threads (default: all cores)\n"
+            "  -o, --out FILE         write every maze as text\n",
+            MIN_MAZE_SIZE, MIN_MAZE_SIZE, GENERATION_TILE_SIZE);
+    }
+
+    bool ParseDifficulty(const char* name, Difficulty& difficulty) {
+        if (std::strcmp(name, "easy") == 0) difficulty = Easy;
+        else if (std::strcmp(name, "medium") == 0) difficulty = Medium;
+        else if (std::strcmp(name, "hard") == 0) difficulty = Hard;
+        else return false;
+        return true;
+    }
+
+    bool ParseAlgorithm(const char* name, MazeAlgorithm& algorithm) {
+        static const struct { const char* name; MazeAlgorithm algorithm; } ALGORITHMS[] = {
+            {"backtracker", MazeAlgorithm::Backtracker},
+            {"kruskal", MazeAlgorithm::Kruskal},
+            {"prim", MazeAlgorithm::Prim},
+            {"wilson", MazeAlgorithm::Wilson},
+            {"binarytree", MazeAlgorithm::BinaryTree},
+            {"sidewinder", MazeAlgorithm::Sidewinder},
+        };
+        for (const auto& entry : ALGORITHMS) {
+            if (std::strcmp(name, entry.name) == 0) {
+                algorithm = entry.algorithm;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            auto is = [arg](const char* shortName, const char* longName) {
+                return (shortName && std::strcmp(arg, shortName) == 0) || std::strcmp(arg, longName) == 0;
+            };
+            auto value = [&]() -> const char* {
+                if (i + 1 < argc) return argv[++i];
+                std::fprintf(stderr, "mazegen: missing value for %s\n", arg);
+                return nullptr;
+            };
+            const char* v = nullptr;
+
+            if (is("-h", "--help")) {
+                return false;
+            } else if (is(nullptr, "--tiled")) {
+                options.generation = GenerationMode::Parallel;
+            } else if (is("-n", "--count")) {
+                if (!(v = value())) return false;
+                options.count = std::atoll(v);
+            } else if (is("-s", "--size")) {
+                if (!(v = value()) || std::sscanf(v, "%dx%d", &options.columns, &options.rows) != 2) return false;
+                if (options.columns < MIN_MAZE_SIZE || options.rows < MIN_MAZE_SIZE) {
+                    std::fprintf(stderr, "mazegen: size %s is below the %dx%d minimum\n", v, MIN_MAZE_SIZE, MIN_MAZE_SIZE);
+                    return false;
+                }
+            } else if (is("-d", "--difficulty")) {
+                if (!(v = value()) || !ParseDifficulty(v, options.difficulty)) return false;
+            } else if (is("-a", "--algorithm")) {
+                if (!(v = value()) || !ParseAlgorithm(v, options.algorithm)) return false;
+                options.overrideAlgorithm = true;
+            } else if (is(nullptr, "--seed")) {
+                if (!(v = value())) return false;
+                options.seed = std::strtoull(v, nullptr, 10);
+            } else if (is("-t", "--threads")) {
+                if (!(v = value())) return false;
+                options.threads = std::atoi(v);
+            } else if (is("-o", "--out")) {
+                if (!(v = value())) return false;
+                options.outPath = v;
+            } else {
+                std::fprintf(stderr, "mazegen: unknown option %s\n", arg);
+                return false;
+            }
+        }
+        return options.count > 0;
+    }
+
+    // FNV-1a over walls and obstacles; equal checksums mean identical maze sets
+    uint64_t HashMaze(const MazeGrid& grid, const MazeBuildResult& result) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 0x100000001B3ull; };
+        for (int y = 0; y < grid.getRows(); y++) {
+            for (int x = 0; x < grid.getColumns(); x++) {
+                mix(grid.Walls(x, y) | (grid.IsObstacle(x, y) << 4));
+            }
+        }
+        mix(static_cast<uint64_t>(result.exitX) << 32 | static_cast<uint32_t>(result.exitY));
+        return hash;
+    }
+
+    void WriteMaze(FILE* out, long long index, uint64_t seed, const MazeGrid& grid, const MazeBuildResult& result) {
+        std::fprintf(out, "maze %lld seed %llu size %dx%d exit %d,%d obstacles %d\n", index,
+                     static_cast<unsigned long long>(seed), grid.getColumns(), grid.getRows(),
+                     result.exitX, result.exitY, result.obstacles);
+
+        std::string line(grid.getColumns(), ' ');
+        for (int y = 0; y < grid.getRows(); y++) {
+            for (int x = 0; x < grid.getColumns(); x++) {
+                int walls = grid.Walls(x, y);
+                line[x] = grid.IsObstacle(x, y) ? static_cast<char>('g' + walls) : "0123456789abcdef"[walls];
+            }
+            std::fprintf(out, "%s\n", line.c_str());
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+
+    MazeRules rules = MazeRules::Get(options.difficulty);
+    if (options.overrideAlgorithm) rules.algorithm = options.algorithm;
+    if (options.threads > 0) omp_set_num_threads(options.threads);
+
+    FILE* out = nullptr;
+    if (options.outPath) {
+        out = std::fopen(options.outPath, "w");
+        if (!out) {
+            std::fprintf(stderr, "mazegen: cannot open %s\n", options.outPath);
+            return 1;
+        }
+    }
+
+    uint64_t checksum = 0;
+    long long obstacles = 0;
+    int threads = 1;
+    auto start = std::chrono::steady_clock::now();
+
+    #pragma omp parallel reduction(^:checksum) reduction(+:obstacles)
+    {
+        #pragma omp single
+        threads = omp_get_num_threads();
+
+        // Per-thread workspace, reused for every maze this thread builds
+        MazeBuilder builder;
+        MazeGrid grid;
+
+        if (out) {
+            // Ordered so the file lists mazes by index whatever the thread count
+            #pragma omp for ordered schedule(dynamic, 4)
+            for (long long i = 0; i < options.count; i++) {
+                MazeBuildResult result = builder.Build(grid, options.columns, options.rows, rules,
+                                                       options.generation, options.seed + i);
+                checksum ^= HashMaze(grid, result) + static_cast<uint64_t>(i);
+                obstacles += result.obstacles;
+
+                #pragma omp ordered
+                WriteMaze(out, i, options.seed + i, grid, result);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 16)
+            for (long long i = 0; i < options.count; i++) {
+                MazeBuildResult result = builder.Build(grid, options.columns, options.rows, rules,
+                                                       options.generation, options.seed + i);
+                checksum ^= HashMaze(grid, result) + static_cast<uint64_t>(i);
+                obstacles += result.obstacles;
+            }
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (out) std::fclose(out);
+
+    double cells = static_cast<double>(options.count) * options.columns * options.rows;
+    std::printf("mazes      %lld (%dx%d, %s, %s%s)\n", options.count, options.columns, options.rows,
+                options.difficulty == Easy ? "easy" : options.difficulty == Medium ? "medium" : "hard",
+                GetMazeAlgorithmName(rules.algorithm), options.generation == GenerationMode::Parallel ? ", tiled" : "");
+    std::printf("threads    %d\n", threads);
+    std::printf("time       %.3f s\n", seconds);
+    std::printf("mazes/s    %.0f\n", options.count / seconds);
+    std::printf("cells/s    %.3e\n", cells / seconds);
+    std::printf("obstacles  %.1f per maze\n", static_cast<double>(obstacles) / options.count);
+    std::printf("checksum   %016llx\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
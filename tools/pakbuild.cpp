@@ -0,0 +1,211 @@
+// Packs the game's assets into one archive the game memory-maps at startup
+// (see src/asset_archive.h for the layout). Images are decoded here once and
+// stored as RGBA8 pixels, optionally deflated; WAV files are re-encoded as QOA
+// unless --raw-audio is given, other audio files are stored as they are.
+//
+// Entries are named by the path given on the command line, which must match
+// the path the game loads, e.g. "Assets/monkey.png" from the repository root.
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "asset_archive.h"
+#include "raylib.h"
+
+namespace {
+    struct Options {
+        const char* outPath = ASSET_ARCHIVE_FILE;
+        bool compress = false;
+        bool rawAudio = false;
+        std::vector<const char*> inputs;
+    };
+
+    struct PackedAsset {
+        AssetEntry entry;
+        std::vector<unsigned char> data;
+    };
+
+    void PrintUsage() {
+        std::printf(
+            "usage: pakbuild [options] FILE...\n"
+            "  -o, --out FILE         archive to write (default %s)\n"
+            "  -c, --compress         deflate image pixels (smaller archive, unpacked on load)\n"
+            "      --raw-audio        store WAV files as they are instead of encoding them as QOA\n",
+            ASSET_ARCHIVE_FILE);
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (std::strcmp(arg, "-h") == 0 || std::strcmp(arg, "--help") == 0) {
+                return false;
+            } else if (std::strcmp(arg, "-o") == 0 || std::strcmp(arg, "--out") == 0) {
+                if (i + 1 >= argc) {
+                    std::fprintf(stderr, "pakbuild: missing value for %s\n", arg);
+                    return false;
+                }
+                options.outPath = argv[++i];
+            } else if (std::strcmp(arg, "-c") == 0 || std::strcmp(arg, "--compress") == 0) {
+                options.compress = true;
+            } else if (std::strcmp(arg, "--raw-audio") == 0) {
+                options.rawAudio = true;
+            } else if (arg[0] == '-') {
+                std::fprintf(stderr, "pakbuild: unknown option %s\n", arg);
+                return false;
+            } else {
+                options.inputs.push_back(arg);
+            }
+        }
+        return !options.inputs.empty();
+    }
+
+    std::vector<unsigned char> ReadFile(const char* fileName) {
+        int size = 0;
+        unsigned char* data = LoadFileData(fileName, &size);
+        std::vector<unsigned char> bytes(data, data + (data != nullptr ? size : 0));
+        UnloadFileData(data);
+        return bytes;
+    }
+
+    bool PackImage(const char* fileName, const Options& options, PackedAsset& asset) {
+        Image image = LoadImage(fileName);
+        if (image.data == nullptr) return false;
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        const int rawSize = image.width * image.height * 4;
+        const unsigned char* pixels = static_cast<const unsigned char*>(image.data);
+        asset.entry.kind = AssetKind::Image;
+        asset.entry.width = static_cast<uint32_t>(image.width);
+        asset.entry.height = static_cast<uint32_t>(image.height);
+        asset.entry.rawSize = static_cast<uint64_t>(rawSize);
+        asset.data.assign(pixels, pixels + rawSize);
+
+        // Only worth an unpack on load when it actually saves space
+        if (options.compress) {
+            int packedSize = 0;
+            unsigned char* packed = CompressData(pixels, rawSize, &packedSize);
+            if (packed != nullptr && packedSize < rawSize) {
+                asset.entry.codec = AssetCodec::Deflate;
+                asset.data.assign(packed, packed + packedSize);
+            }
+            MemFree(packed);
+        }
+        UnloadImage(image);
+        return true;
+    }
+
+    bool PackAudio(const char* fileName, const Options& options, PackedAsset& asset) {
+        const char* extension = GetFileExtension(fileName);
+        asset.entry.kind = AssetKind::Audio;
+
+        if (!options.rawAudio && extension != nullptr && std::strcmp(extension, ".wav") == 0) {
+            // QOA needs 16-bit samples; raylib only encodes to a file, so go through a temporary one
+            Wave wave = LoadWave(fileName);
+            if (wave.data == nullptr) return false;
+            WaveFormat(&wave, static_cast<int>(wave.sampleRate), 16, static_cast<int>(wave.channels));
+            const std::string temporary = std::string(options.outPath) + ".tmp.qoa";
+            const bool exported = ExportWave(wave, temporary.c_str());
+            UnloadWave(wave);
+            if (exported) {
+                asset.data = ReadFile(temporary.c_str());
+                std::remove(temporary.c_str());
+                std::strcpy(asset.entry.fileType, ".qoa");
+            }
+            if (!asset.data.empty()) {
+                asset.entry.rawSize = asset.data.size();
+                return true;
+            }
+            std::fprintf(stderr, "pakbuild: could not encode %s as QOA, storing it as is\n", fileName);
+        }
+
+        asset.data = ReadFile(fileName);
+        if (asset.data.empty() || extension == nullptr || std::strlen(extension) >= sizeof(asset.entry.fileType)) return false;
+        std::strcpy(asset.entry.fileType, extension);
+        asset.entry.rawSize = asset.data.size();
+        return true;
+    }
+
+    bool IsAudio(const char* fileName) {
+        return IsFileExtension(fileName, ".wav;.ogg;.mp3;.qoa;.flac");
+    }
+
+    bool WriteArchive(const char* outPath, std::vector<PackedAsset>& assets) {
+        std::sort(assets.begin(), assets.end(), [](const PackedAsset& a, const PackedAsset& b) {
+            return std::strcmp(a.entry.name, b.entry.name) < 0;
+        });
+
+        // Header and index first, then each entry's data on an aligned offset
+        uint64_t offset = sizeof(AssetArchiveHeader) + assets.size() * sizeof(AssetEntry);
+        for (PackedAsset& asset : assets) {
+            offset = (offset + ASSET_DATA_ALIGNMENT - 1) / ASSET_DATA_ALIGNMENT * ASSET_DATA_ALIGNMENT;
+            asset.entry.offset = offset;
+            asset.entry.size = asset.data.size();
+            offset += asset.data.size();
+        }
+
+        FILE* out = std::fopen(outPath, "wb");
+        if (out == nullptr) return false;
+        AssetArchiveHeader header = {};
+        std::memcpy(header.magic, ASSET_ARCHIVE_MAGIC, sizeof(header.magic));
+        header.version = ASSET_ARCHIVE_VERSION;
+        header.entryCount = static_cast<uint32_t>(assets.size());
+        bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+        for (const PackedAsset& asset : assets) {
+            ok = ok && std::fwrite(&asset.entry, sizeof(AssetEntry), 1, out) == 1;
+        }
+        for (const PackedAsset& asset : assets) {
+            while (ok && static_cast<uint64_t>(std::ftell(out)) < asset.entry.offset) ok = std::fputc(0, out) != EOF;
+            ok = ok && std::fwrite(asset.data.data(), 1, asset.data.size(), out) == asset.data.size();
+        }
+        return std::fclose(out) == 0 && ok;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::vector<PackedAsset> assets;
+    for (const char* fileName : options.inputs) {
+        if (std::strlen(fileName) >= static_cast<size_t>(ASSET_NAME_LENGTH)) {
+            std::fprintf(stderr, "pakbuild: name too long for the index: %s\n", fileName);
+            return 1;
+        }
+        PackedAsset asset = {};
+        std::strcpy(asset.entry.name, fileName);
+        const bool packed = IsAudio(fileName) ? PackAudio(fileName, options, asset) : PackImage(fileName, options, asset);
+        if (!packed) {
+            std::fprintf(stderr, "pakbuild: could not load %s\n", fileName);
+            return 1;
+        }
+        for (const PackedAsset& other : assets) {
+            if (std::strcmp(other.entry.name, fileName) == 0) {
+                std::fprintf(stderr, "pakbuild: %s given twice\n", fileName);
+                return 1;
+            }
+        }
+        std::printf("%-40s %8zu bytes%s\n", fileName, asset.data.size(),
+                    asset.entry.codec == AssetCodec::Deflate ? " (deflate)" : "");
+        assets.push_back(std::move(asset));
+    }
+
+    if (!WriteArchive(options.outPath, assets)) {
+        std::fprintf(stderr, "pakbuild: could not write %s\n", options.outPath);
+        return 1;
+    }
+
+    // Read it back the way the game will
+    AssetArchive archive;
+    if (!archive.Open(options.outPath) || archive.getEntryCount() != static_cast<int>(assets.size())) {
+        std::fprintf(stderr, "pakbuild: %s does not read back\n", options.outPath);
+        return 1;
+    }
+    std::printf("wrote %s: %d assets\n", options.outPath, archive.getEntryCount());
+    return 0;
+}